@@ -0,0 +1,133 @@
+/*
+ *  version 1.0 / October 2026 / paulvha
+ *
+ *  This example will read the Mass, Temperature and humidity of many sen6x sensors connected
+ *  behind TCA9548A I2C multiplexers.
+ *
+ *  All sen6x (except SEN60) have the same I2C address 0x6B. A TCA9548A has 8 channels and its
+ *  address can be set between 0x70 and 0x77 (pins A0, A1, A2). Connect each sen6x to a channel.
+ *
+ *  The values of all sensors are read in one sweep. The command is send to the next sensor while
+ *  the other sensors are still executing, so a sweep takes about as long as reading one sensor.
+ *
+ *  ..........................................................
+ *  SEN6x Pinout (backview)
+ *
+ *  ---------------------
+ *  !   | 123456 /      \|
+ *  !___|_______/        |
+ *  !           \       /|
+ *  !            \     / |
+ *  !-------------=====---
+ *  .........................................................
+ *
+ *  SEN6X pin     TCA9548A channel
+ *  1 VCC -------- 3v3
+ *  2 GND -------- GND
+ *  3 SDA -------- SDx
+ *  4 SCL -------- SCx
+ *  5 internal connected to pin 2
+ *  6 internal connected to Pin 1
+ *
+ *  SDA and SCL of the TCA9548A are connected to the board.
+ *  Be aware to add pull-up resistors to 3V3 on each channel as most breakout boards don't have those
+ * ..................................................................
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *  ===================================================================================
+ *
+ *  NO support, delivered as is, have fun, good luck !!
+ *
+ */
+
+#include "sen6x_multi.h"
+
+/////////////////////////////////////////////////////////////
+/* define which Wire interface */
+////////////////////////////////////////////////////////////
+#define WIRE_sen6x Wire
+
+/////////////////////////////////////////////////////////////
+/* define the sensors connected : type, TCA9548A address, channel */
+////////////////////////////////////////////////////////////
+struct {
+  SEN6x_device device;
+  uint8_t mux;
+  uint8_t channel;
+} Sensors[] = {
+  {SEN66, 0x70, 0},
+  {SEN66, 0x70, 1},
+  {SEN66, 0x70, 2},
+  {SEN68, 0x71, 0}
+};
+
+///////////////////////////////////////////////////////////////
+/////////// NO CHANGES BEYOND THIS POINT NEEDED ///////////////
+///////////////////////////////////////////////////////////////
+
+SEN6xMulti multi;
+
+struct sen6x_values val;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(100);
+
+  Serial.println(F("SEN6x-Example10: Display values of many sen6x."));
+
+  WIRE_sen6x.begin();
+
+  multi.begin(&WIRE_sen6x);
+
+  for (uint8_t i = 0; i < sizeof(Sensors) / sizeof(Sensors[0]); i++) {
+    if (multi.add(Sensors[i].device, Sensors[i].mux, Sensors[i].channel) < 0) {
+      Serial.print(F("Could not add sensor "));
+      Serial.println(i);
+    }
+  }
+
+  if (multi.start() != SEN6x_ERR_OK) {
+    for (uint8_t i = 0; i < multi.GetCount(); i++) {
+      if (multi.GetResult(i) != SEN6x_ERR_OK) {
+        Serial.print(F("Could not start sensor "));
+        Serial.println(i);
+      }
+    }
+  }
+
+  // give some time to start
+  delay(1000);
+}
+
+void loop() {
+  uint8_t i;
+
+  delay(1000);
+
+  multi.update();
+
+  for (i = 0; i < multi.GetCount(); i++) {
+
+    Serial.print(F("Sensor "));
+    Serial.print(i);
+
+    if (multi.GetValues(i, &val) != SEN6x_ERR_OK) {
+      Serial.println(F("\tError during reading values"));
+      continue;
+    }
+
+    Serial.print(F("\tPM2.5 "));
+    Serial.print(val.MassPM2);
+    Serial.print(F("\tHum "));
+    Serial.print(val.Hum);
+    Serial.print(F("\tTemp "));
+    Serial.println(val.Temp);
+  }
+}
@@ -0,0 +1,178 @@
+/*
+ *  version 1.0 / October 2026 / paulvha
+ *
+ *  This example will connect to the sen6x and read the Mass, VOC, NOx, Temperature and humidity
+ *  information once every measurement WITHOUT checking the data ready flag each time.
+ *
+ *  The SEN6xSampler learns in the first seconds at which moment the sen6x has a new measurement.
+ *  After that it only reads the values, just after each new measurement. Every 30 measurements
+ *  it verifies the moment is still right. The sketch shows the number of data ready checks and
+ *  the number of measurements read.
+ *
+ *  ..........................................................
+ *  SEN6x Pinout (backview)
+ *
+ *  ---------------------
+ *  !   | 123456 /      \|
+ *  !___|_______/        |
+ *  !           \       /|
+ *  !            \     / |
+ *  !-------------=====---
+ *  .........................................................
+ *
+ *  Connection example UNO R4
+ *  Wire1
+ *                Qwiic connector
+ *  SEN6X pin     UNOR4
+ *  1 VCC -------- 3v3
+ *  2 GND -------- GND
+ *  3 SDA -------- SDA
+ *  4 SCL -------- SCL
+ *  5 internal connected to pin 2
+ *  6 internal connected to Pin 1
+ *
+ *  The pull-up resistors are already installed on the UNOR4 for Wire1.
+ * ..................................................................
+ *
+ *  There is NO reason why this sketch would not work on other MCU / board.
+ *  Be aware to add pull-up resistors to 3V3 as I2C on most boards don't have those
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *  ===================================================================================
+ *
+ *  NO support, delivered as is, have fun, good luck !!
+ *
+ */
+
+#include "sen6x_sampler.h"
+
+///////////////////////////////////////////////////////////////
+/* define the SEN6x sensor connected
+ * valid values, SEN60, SEN63, SEN63C, SEN65, SEN66 or SEN68 */
+///////////////////////////////////////////////////////////////
+const SEN6x_device Device = SEN66;
+
+/////////////////////////////////////////////////////////////
+/* define which Wire interface */
+////////////////////////////////////////////////////////////
+#define WIRE_sen6x Wire1
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request debug messages */
+////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+///////////////////////////////////////////////////////////////
+/////////// NO CHANGES BEYOND THIS POINT NEEDED ///////////////
+///////////////////////////////////////////////////////////////
+
+SEN6x sen6x;
+SEN6xSampler sampler(&sen6x);
+
+struct sen6x_values val;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(100);
+
+  Serial.println(F("SEN6x-Example11: Display values with the cadence-locked sampler."));
+
+  // set library debug level
+  sen6x.EnableDebugging(DEBUG);
+
+  WIRE_sen6x.begin();
+
+  // Begin communication channel;
+  if (! sen6x.begin(&WIRE_sen6x)) {
+    Serial.println(F("Could not auto-detect SEN6x. Assume as defined in sketch."));
+
+    // inform the library about the SEN6x sensor connected
+    sen6x.SetDevice(Device);
+  }
+
+  // check for connection
+  if (! sen6x.probe()) {
+    Serial.println(F("Could not probe / connect with sen6x. \nDid you define the right sensor in sketch?"));
+    while(1);
+  }
+  else  {
+    Serial.println(F("Connected sen6x."));
+  }
+
+  // reset SEN6x
+  if (! sen6x.reset()) {
+    Serial.println(F("Could not reset sen6x. Freeze."));
+    while(1);
+  }
+
+  if (! sen6x.start()) {
+    Serial.println(F("Could not Start sen6x.Freeze. "));
+    while(1);
+  }
+
+  // start learning the moment of measurement
+  sampler.begin();
+}
+
+void loop() {
+
+  if (sampler.available(&val)) {
+    Display_val();
+
+    Serial.print(F("Checks: "));
+    Serial.print(sampler.GetChecks());
+    Serial.print(F("\tMeasurements: "));
+    Serial.print(sampler.GetSamples());
+    Serial.print(F("\tResyncs: "));
+    Serial.print(sampler.GetResyncs());
+    Serial.println(sampler.IsLocked() ? F("\tlocked") : F("\tlearning"));
+  }
+
+  // do other things here
+}
+
+void Display_val()
+{
+  Serial.print(F("PM1.0: "));
+  Serial.print(val.MassPM1);
+  Serial.print(F("\tPM2.5: "));
+  Serial.print(val.MassPM2);
+  Serial.print(F("\tPM4.0: "));
+  Serial.print(val.MassPM4);
+  Serial.print(F("\tPM10: "));
+  Serial.print(val.MassPM10);
+
+  if(Device != SEN60) {
+    if (Device != SEN63) {
+      Serial.print(F("\tVOC: "));
+      Serial.print(val.VOC);
+      Serial.print(F("\tNOx: "));
+      Serial.print(val.NOX);
+    }
+
+    Serial.print(F("\tHum: "));
+    Serial.print(val.Hum);
+    Serial.print(F("\tTemp: "));
+    Serial.print(val.Temp,2);
+
+    if (Device == SEN66 || Device == SEN63) {
+      Serial.print(F("\tCO2: "));
+      Serial.print(val.CO2);
+    }
+    else if (Device == SEN68) {
+      Serial.print(F("\tHCHO: "));
+      Serial.print(val.HCHO,2);
+    }
+  }
+
+  Serial.println();
+}
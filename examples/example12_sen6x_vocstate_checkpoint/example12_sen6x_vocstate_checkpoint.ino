@@ -0,0 +1,191 @@
+/*
+ *  version 1.0 / October 2026 / paulvha
+ *
+ *  This example will read the MASS / VOC values and keep the VOC algorithm state in EEPROM.
+ *
+ *  The VOC algorithm learns for hours before the VOC index is reliable. After a power cycle the
+ *  learning starts again, unless the VOC algorithm state is restored.
+ *
+ *  Every 10 minutes the VOC algorithm state is read (the measurement is not stopped) and saved
+ *  in the EEPROM. At start the last saved state is restored in the sen6x, so valid VOC indices are
+ *  available straight away. The saves are spread over 8 slots in the EEPROM to reduce wear.
+ *  On ESP32, ESP8266 and RP2040 the EEPROM is emulated in a flash page.
+ *
+ *  Only for SEN65, SEN66 and SEN68
+ *
+ *  ..........................................................
+ *  SEN6x Pinout (backview)
+ *
+ *  ---------------------
+ *  !   | 123456 /      \|
+ *  !___|_______/        |
+ *  !           \       /|
+ *  !            \     / |
+ *  !-------------=====---
+ *  .........................................................
+ *
+ *  Connection example UNO R4
+ *  Wire1
+ *                Qwiic connector
+ *  SEN6X pin     UNOR4
+ *  1 VCC -------- 3v3
+ *  2 GND -------- GND
+ *  3 SDA -------- SDA
+ *  4 SCL -------- SCL
+ *  5 internal connected to pin 2
+ *  6 internal connected to Pin 1
+ *
+ *  The pull-up resistors are already installed on the UNOR4 for Wire1.
+ * ..................................................................
+ *
+ *  There is NO reason why this sketch would not work on other MCU / board.
+ *  Be aware to add pull-up resistors to 3V3 as I2C on most boards don't have those
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *  ===================================================================================
+ *
+ *  NO support, delivered as is, have fun, good luck !!
+ *
+ */
+
+#include "sen6x_checkpoint.h"
+#include "sen6x_eeprom.h"
+
+///////////////////////////////////////////////////////////////
+/* define the SEN6x sensor connected
+ * valid values, SEN60, SEN63, SEN63C, SEN65, SEN66 or SEN68 */
+///////////////////////////////////////////////////////////////
+const SEN6x_device Device = SEN66;
+
+/////////////////////////////////////////////////////////////
+/* define which Wire interface */
+////////////////////////////////////////////////////////////
+#define WIRE_sen6x Wire1
+
+/////////////////////////////////////////////////////////////
+/* define first byte in EEPROM to use (needs 8 x 15 bytes) */
+////////////////////////////////////////////////////////////
+#define EEPROM_BASE 0
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request debug messages */
+////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+///////////////////////////////////////////////////////////////
+/////////// NO CHANGES BEYOND THIS POINT NEEDED ///////////////
+///////////////////////////////////////////////////////////////
+
+SEN6x sen6x;
+SEN6xEEPROM eeprom;
+SEN6xCheckpoint checkpoint(&sen6x, &eeprom, EEPROM_BASE);
+
+struct sen6x_values val;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(100);
+
+  Serial.println(F("SEN6x-Example12: Display values and keep VOC algorithm state in EEPROM."));
+
+  // set library debug level
+  sen6x.EnableDebugging(DEBUG);
+
+  WIRE_sen6x.begin();
+
+  // Begin communication channel;
+  if (! sen6x.begin(&WIRE_sen6x)) {
+    Serial.println(F("Could not auto-detect SEN6x. Assume as defined in sketch."));
+
+    // inform the library about the SEN6x sensor connected
+    sen6x.SetDevice(Device);
+  }
+
+  // check for connection
+  if (! sen6x.probe()) {
+    Serial.println(F("Could not probe / connect with sen6x. \nDid you define the right sensor in sketch?"));
+    while(1);
+  }
+  else  {
+    Serial.println(F("Connected sen6x."));
+  }
+
+  // reset SEN6x
+  if (! sen6x.reset()) {
+    Serial.println(F("Could not reset sen6x. Freeze."));
+    while(1);
+  }
+
+  // restore the VOC algorithm state, before start
+  eeprom.begin();
+
+  if (checkpoint.begin() != SEN6x_ERR_OK)
+    Serial.println(F("Could not restore VOC algorithm state."));
+  else if (checkpoint.IsRestored())
+    Serial.println(F("Restored VOC algorithm state."));
+  else
+    Serial.println(F("No VOC algorithm state saved yet."));
+
+  if (! sen6x.start()) {
+    Serial.println(F("Could not Start sen6x.Freeze. "));
+    while(1);
+  }
+}
+
+void loop() {
+
+  // save VOC algorithm state when interval has passed
+  if (checkpoint.update() != SEN6x_ERR_OK)
+    Serial.println(F("Could not save VOC algorithm state."));
+
+  if (! sen6x.CheckDataReady()) return;
+
+  if (sen6x.GetValues(&val) == SEN6x_ERR_OK) Display_val();
+  else Serial.println(F("Could not read values."));
+}
+
+void Display_val()
+{
+  Serial.print(F("PM1.0: "));
+  Serial.print(val.MassPM1);
+  Serial.print(F("\tPM2.5: "));
+  Serial.print(val.MassPM2);
+  Serial.print(F("\tPM4.0: "));
+  Serial.print(val.MassPM4);
+  Serial.print(F("\tPM10: "));
+  Serial.print(val.MassPM10);
+
+  if(Device != SEN60) {
+    if (Device != SEN63) {
+      Serial.print(F("\tVOC: "));
+      Serial.print(val.VOC);
+      Serial.print(F("\tNOx: "));
+      Serial.print(val.NOX);
+    }
+
+    Serial.print(F("\tHum: "));
+    Serial.print(val.Hum);
+    Serial.print(F("\tTemp: "));
+    Serial.print(val.Temp,2);
+
+    if (Device == SEN66 || Device == SEN63) {
+      Serial.print(F("\tCO2: "));
+      Serial.print(val.CO2);
+    }
+    else if (Device == SEN68) {
+      Serial.print(F("\tHCHO: "));
+      Serial.print(val.HCHO,2);
+    }
+  }
+
+  Serial.println();
+}
@@ -14,7 +14,8 @@
  *  
  *  Pressing enter during the measurement will display the current VOC-values and provide a menu to
  *  save, display and/or restore previous saved parameters. The save parameters are not retained after 
- *  a reset of the sketch, it is only available to demonstrate and learn.
+ *  a reset of the sketch, it is only available to demonstrate and learn. See Example12 to keep the
+ *  state in EEPROM across a power cycle.
  *  
  *  There is NO information available about the meaning of the 8 different bytes and thus there is NO 
  *  edit option in the menu. Once more information is available, the sketch will be updated
@@ -0,0 +1,205 @@
+/*
+ *  version 1.0 / October 2026 / paulvha
+ *
+ *  This example will connect to the sen6x and read the Mass, VOC, NOx, Temperature and humidity
+ *  information WITHOUT blocking the loop() while the sen6x is executing the command.
+ *
+ *  The command is submitted with submit(), and poll() is called in each loop(). Once the command
+ *  has been executed on the sen6x, the result is read and can be decoded with ParseDataReady()
+ *  and ParseValues(). In the meantime the loop() counts how often it was called, to show the
+ *  time that is now available for other tasks.
+ *
+ *  ..........................................................
+ *  SEN6x Pinout (backview)
+ *
+ *  ---------------------
+ *  !   | 123456 /      \|
+ *  !___|_______/        |
+ *  !           \       /|
+ *  !            \     / |
+ *  !-------------=====---
+ *  .........................................................
+ *
+ *  Connection example UNO R4
+ *  Wire1
+ *                Qwiic connector
+ *  SEN6X pin     UNOR4
+ *  1 VCC -------- 3v3
+ *  2 GND -------- GND
+ *  3 SDA -------- SDA
+ *  4 SCL -------- SCL
+ *  5 internal connected to pin 2
+ *  6 internal connected to Pin 1
+ *
+ *  The pull-up resistors are already installed on the UNOR4 for Wire1.
+ * ..................................................................
+ *
+ *  There is NO reason why this sketch would not work on other MCU / board.
+ *  Be aware to add pull-up resistors to 3V3 as I2C on most boards don't have those
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *  ===================================================================================
+ *
+ *  NO support, delivered as is, have fun, good luck !!
+ *
+ */
+
+#include "sen6x.h"
+
+///////////////////////////////////////////////////////////////
+/* define the SEN6x sensor connected
+ * valid values, SEN60, SEN63, SEN63C, SEN65, SEN66 or SEN68 */
+///////////////////////////////////////////////////////////////
+const SEN6x_device Device = SEN66;
+
+/////////////////////////////////////////////////////////////
+/* define which Wire interface */
+////////////////////////////////////////////////////////////
+#define WIRE_sen6x Wire1
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request debug messages */
+////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+///////////////////////////////////////////////////////////////
+/////////// NO CHANGES BEYOND THIS POINT NEEDED ///////////////
+///////////////////////////////////////////////////////////////
+
+SEN6x sen6x;
+
+struct sen6x_values val;
+
+// what is the sketch waiting for
+enum {
+  SUBMIT_READY,   // submit data ready check
+  WAIT_READY,     // wait for data ready result
+  WAIT_VALUES,    // wait for values result
+} state = SUBMIT_READY;
+
+unsigned long loops = 0;         // count loop() calls while waiting
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(100);
+
+  Serial.println(F("SEN6x-Example8: Display values without blocking."));
+
+  // set library debug level
+  sen6x.EnableDebugging(DEBUG);
+
+  WIRE_sen6x.begin();
+
+  // Begin communication channel;
+  if (! sen6x.begin(&WIRE_sen6x)) {
+    Serial.println(F("Could not auto-detect SEN6x. Assume as defined in sketch."));
+
+    // inform the library about the SEN6x sensor connected
+    sen6x.SetDevice(Device);
+  }
+
+  // check for connection
+  if (! sen6x.probe()) {
+    Serial.println(F("Could not probe / connect with sen6x. \nDid you define the right sensor in sketch?"));
+    while(1);
+  }
+  else  {
+    Serial.println(F("Connected sen6x."));
+  }
+
+  // reset SEN6x
+  if (! sen6x.reset()) {
+    Serial.println(F("Could not reset sen6x. Freeze."));
+    while(1);
+  }
+
+  // submit() does not start the measurement
+  if (! sen6x.start()) {
+    Serial.println(F("Could not Start sen6x.Freeze. "));
+    while(1);
+  }
+}
+
+void loop() {
+  bool ready;
+
+  loops++;
+
+  switch(state) {
+
+    case SUBMIT_READY:
+      if (sen6x.submit(SEN6x_READ_DATA_RDY_FLAG) == SEN6x_ERR_OK) state = WAIT_READY;
+      break;
+
+    case WAIT_READY:
+      if (! sen6x.poll()) break;      // still executing on sen6x
+
+      if (sen6x.ParseDataReady(&ready) != SEN6x_ERR_OK || ! ready) {
+        state = SUBMIT_READY;
+        break;
+      }
+
+      if (sen6x.submit(SEN6x_READ_MEASURED_VALUE) == SEN6x_ERR_OK) state = WAIT_VALUES;
+      else state = SUBMIT_READY;
+      break;
+
+    case WAIT_VALUES:
+      if (! sen6x.poll()) break;      // still executing on sen6x
+
+      if (sen6x.ParseValues(&val) == SEN6x_ERR_OK) Display_val();
+      else Serial.println(F("Could not read values."));
+
+      loops = 0;
+      state = SUBMIT_READY;
+      break;
+  }
+
+  // do other things here
+}
+
+void Display_val()
+{
+  Serial.print(F("PM1.0: "));
+  Serial.print(val.MassPM1);
+  Serial.print(F("\tPM2.5: "));
+  Serial.print(val.MassPM2);
+  Serial.print(F("\tPM4.0: "));
+  Serial.print(val.MassPM4);
+  Serial.print(F("\tPM10: "));
+  Serial.print(val.MassPM10);
+
+  if(Device != SEN60) {
+    if (Device != SEN63) {
+      Serial.print(F("\tVOC: "));
+      Serial.print(val.VOC);
+      Serial.print(F("\tNOx: "));
+      Serial.print(val.NOX);
+    }
+
+    Serial.print(F("\tHum: "));
+    Serial.print(val.Hum);
+    Serial.print(F("\tTemp: "));
+    Serial.print(val.Temp,2);
+
+    if (Device == SEN66 || Device == SEN63) {
+      Serial.print(F("\tCO2: "));
+      Serial.print(val.CO2);
+    }
+    else if (Device == SEN68) {
+      Serial.print(F("\tHCHO: "));
+      Serial.print(val.HCHO,2);
+    }
+  }
+
+  Serial.print(F("\tloops: "));
+  Serial.println(loops);
+}
@@ -0,0 +1,127 @@
+/*
+ *  version 1.0 / October 2026 / paulvha
+ *
+ *  This example will connect to the sen6x and read the Mass, VOC, NOx, Temperature and humidity
+ *  information with SEN6xT, the driver that is specialized at compile time for ONE type of sen6x.
+ *
+ *  The opcodes, execution times and frame lengths are constants and only the code for the selected
+ *  sensor is included. Calling a function that the selected sensor does not support (e.g.
+ *  ForceCO2Recal() on a SEN65) will give a compile error.
+ *
+ *  ..........................................................
+ *  SEN6x Pinout (backview)
+ *
+ *  ---------------------
+ *  !   | 123456 /      \|
+ *  !___|_______/        |
+ *  !           \       /|
+ *  !            \     / |
+ *  !-------------=====---
+ *  .........................................................
+ *
+ *  Connection example UNO R4
+ *  Wire1
+ *                Qwiic connector
+ *  SEN6X pin     UNOR4
+ *  1 VCC -------- 3v3
+ *  2 GND -------- GND
+ *  3 SDA -------- SDA
+ *  4 SCL -------- SCL
+ *  5 internal connected to pin 2
+ *  6 internal connected to Pin 1
+ *
+ *  The pull-up resistors are already installed on the UNOR4 for Wire1.
+ * ..................................................................
+ *
+ *  There is NO reason why this sketch would not work on other MCU / board.
+ *  Be aware to add pull-up resistors to 3V3 as I2C on most boards don't have those
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *  ===================================================================================
+ *
+ *  NO support, delivered as is, have fun, good luck !!
+ *
+ */
+
+#include "sen6x_template.h"
+
+/////////////////////////////////////////////////////////////
+/* define which Wire interface */
+////////////////////////////////////////////////////////////
+#define WIRE_sen6x Wire1
+
+///////////////////////////////////////////////////////////////
+/* define the SEN6x sensor connected
+ * valid values, SEN60, SEN63C, SEN65, SEN66 or SEN68 */
+///////////////////////////////////////////////////////////////
+SEN6xT<SEN66> sen6x;
+
+///////////////////////////////////////////////////////////////
+/////////// NO CHANGES BEYOND THIS POINT NEEDED ///////////////
+///////////////////////////////////////////////////////////////
+
+SEN6xTwoWire bus(&WIRE_sen6x);
+
+struct sen6x_values val;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(100);
+
+  Serial.println(F("SEN6x-Example9: Display values with compile-time driver."));
+
+  WIRE_sen6x.begin();
+
+  // Begin communication channel;
+  if (! sen6x.begin(&bus)) {
+    Serial.println(F("Could not connect with sen6x. \nDid you define the right sensor in sketch?"));
+    while(1);
+  }
+
+  Serial.println(F("Connected sen6x."));
+
+  // reset SEN6x
+  if (! sen6x.reset()) {
+    Serial.println(F("Could not reset sen6x. Freeze."));
+    while(1);
+  }
+}
+
+void loop() {
+
+  delay(1000);
+
+  // GetValues() will start the measurement if needed
+  if (! sen6x.CheckDataReady()) return;
+
+  if (sen6x.GetValues(&val) != SEN6x_ERR_OK) {
+    Serial.println(F("Error during reading values"));
+    return;
+  }
+
+  Serial.print(F("PM1 "));
+  Serial.print(val.MassPM1);
+  Serial.print(F("\tPM2.5 "));
+  Serial.print(val.MassPM2);
+  Serial.print(F("\tPM4 "));
+  Serial.print(val.MassPM4);
+  Serial.print(F("\tPM10 "));
+  Serial.print(val.MassPM10);
+  Serial.print(F("\tHum "));
+  Serial.print(val.Hum);
+  Serial.print(F("\tTemp "));
+  Serial.print(val.Temp);
+  Serial.print(F("\tVOC "));
+  Serial.print(val.VOC);
+  Serial.print(F("\tNOx "));
+  Serial.print(val.NOX);
+  Serial.print(F("\tCO2 "));
+  Serial.println(val.CO2);
+}
@@ -0,0 +1,355 @@
+/**
+ * SEN6x Library host regression test
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Runs the driver on a Linux host against the simulator (sen6x_sim.h),
+ * without a sensor. See the Makefile in this folder, run with :
+ *
+ *  make test
+ *
+ * For each of SEN60, SEN63C, SEN65, SEN66 and SEN68 :
+ *  - device detection, measured / raw / concentration values
+ *  - VOC / NOx tuning and VOC algorithm state
+ *  - CO2 forced recalibration, self calibration, pressure and altitude
+ *  - temperature compensation and acceleration
+ *  - injected faults : CRC, short read, NACK, stuck bus and status
+ *  - SEN6xT<device> decodes the same as SEN6x
+ *
+ * The Linux i2c-dev transport (sen6x_linux.h) is tested with a user-space
+ * stand-in that passes the I2C messages to the simulator.
+ *
+ * Each failed check is printed. The exit code is the number of failed
+ * checks.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x.h"
+#include "sen6x_sim.h"
+#include "sen6x_linux.h"
+#include "sen6x_template.h"
+
+static const char *Names[5] = {"SEN60", "SEN63C", "SEN65", "SEN66", "SEN68"};
+
+static int Fails = 0;
+
+#define CHECK(x) do { if (! (x)) { printf("  FAIL %s:%d %s\n", __FILE__, __LINE__, #x); Fails++; } } while (0)
+
+/**
+ * user-space stand-in for i2c-dev : the messages go to the simulator
+ */
+class SEN6xSimI2C : public SEN6xLinuxI2C
+{
+  public:
+    SEN6xSimI2C(SEN6xSim *sim) : _sim(sim) {}
+
+  protected:
+    int Transfer(struct i2c_msg *msgs, int nmsgs) {
+      uint8_t got;
+      int i;
+
+      for (i = 0; i < nmsgs; i++) {
+        if (msgs[i].flags & I2C_M_RD) {
+          if (_sim->read(msgs[i].addr, msgs[i].buf, msgs[i].len, &got) != SEN6x_ERR_OK) return(-1);
+          if (got != msgs[i].len) return(-1);
+        }
+        else if (_sim->write(msgs[i].addr, msgs[i].buf, msgs[i].len) != SEN6x_ERR_OK) return(-1);
+      }
+
+      return(0);
+    }
+
+  private:
+    SEN6xSim *_sim;
+};
+
+static bool HasRaw(SEN6x_device d)   { return(d != SEN60); }
+static bool HasXox(SEN6x_device d)   { return(d == SEN65 || d == SEN66 || d == SEN68); }
+static bool HasCO2(SEN6x_device d)   { return(d == SEN63C || d == SEN66); }
+
+/**
+ * detection, product name and version
+ */
+static void TestInfo(SEN6x &s, SEN6x_device d)
+{
+  struct sen6x_version v;
+  char name[32];
+  bool detected;
+
+  CHECK(s.GetDevice(&detected) == d);
+  CHECK(detected);
+
+  memset(name, 'x', sizeof(name));
+  CHECK(s.GetProductName(name, sizeof(name)) == SEN6x_ERR_OK);
+  CHECK(strcmp(name, Names[d]) == 0);
+
+  CHECK(s.GetSerialNumber(name, sizeof(name)) == SEN6x_ERR_OK);
+  CHECK(strlen(name) > 0);
+
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+  CHECK(v.F_major == 4);
+}
+
+/**
+ * measured, raw and concentration values
+ */
+static void TestValues(SEN6x &s, SEN6x_device d)
+{
+  struct sen6x_values v;
+  struct sen6x_raw_values r;
+  struct sen6x_concentration_values c;
+  uint8_t ret;
+
+  // first read starts the measurement and waits for the first result
+  CHECK(s.GetValues(&v) == SEN6x_ERR_OK);
+  CHECK(v.MassPM2 > 8.65 && v.MassPM2 < 8.75);
+  CHECK(d == SEN60 ? v.Temp == 0 : (v.Temp > 22.25 && v.Temp < 22.35));
+  CHECK(HasXox(d) ? (v.VOC > 99.9 && v.VOC < 100.1) : v.VOC == 0);
+  CHECK(HasCO2(d) ? v.CO2 == 612 : v.CO2 == 0);
+  CHECK(d == SEN68 ? (v.HCHO > 12.25 && v.HCHO < 12.35) : v.HCHO == 0);
+
+  ret = s.GetRawValues(&r);
+  CHECK(HasRaw(d) ? ret == SEN6x_ERR_OK : ret == SEN6x_ERR_UNKNOWNCMD);
+  if (HasRaw(d)) CHECK(r.Hum == 4520 && r.Temp == 4460);
+  if (HasXox(d)) CHECK(r.VOC == 30215 && r.NOX == 16712);
+
+  CHECK(s.GetConcentration(&c) == SEN6x_ERR_OK);
+  CHECK(c.NumPM10 > 41.95 && c.NumPM10 < 42.05);
+
+  // 1 Hz data ready
+  while (! s.CheckDataReady()) delay(50);
+  CHECK(s.GetValues(&v) == SEN6x_ERR_OK);
+  CHECK(! s.CheckDataReady());
+}
+
+/**
+ * VOC / NOx tuning and VOC algorithm state
+ */
+static void TestXox(SEN6x &s)
+{
+  uint8_t st[VOC_ALO_SIZE], st2[VOC_ALO_SIZE], i;
+  sen6x_xox x;
+
+  CHECK(s.GetVocAlgorithm(&x) == SEN6x_ERR_OK);
+  CHECK(x.IndexOffset == 100 && x.GateMaxDurationMin == 180 && x.stdInitial == 50);
+
+  // stdInitial out of range is set to default, GateMaxDurationMin is kept
+  x.IndexOffset = 150;
+  x.GateMaxDurationMin = 5;
+  x.stdInitial = 5;
+  CHECK(s.SetVocAlgorithm(&x) == SEN6x_ERR_OK);
+  s.ClearCache();
+  CHECK(s.GetVocAlgorithm(&x) == SEN6x_ERR_OK);
+  CHECK(x.IndexOffset == 150 && x.GateMaxDurationMin == 5 && x.stdInitial == 50);
+
+  CHECK(s.GetNoxAlgorithm(&x) == SEN6x_ERR_OK);
+  CHECK(x.IndexOffset == 1 && x.GateMaxDurationMin == 720);
+  x.IndexOffset = 2;
+  CHECK(s.SetNoxAlgorithm(&x) == SEN6x_ERR_OK);
+  s.ClearCache();
+  CHECK(s.GetNoxAlgorithm(&x) == SEN6x_ERR_OK);
+  CHECK(x.IndexOffset == 2);
+
+  for (i = 0; i < VOC_ALO_SIZE; i++) st[i] = i + 1;
+  CHECK(s.SetVocAlgorithmState(st, VOC_ALO_SIZE) == SEN6x_ERR_OK);
+  CHECK(s.GetVocAlgorithmState(st2, VOC_ALO_SIZE) == SEN6x_ERR_OK);
+  CHECK(memcmp(st, st2, VOC_ALO_SIZE) == 0);
+}
+
+/**
+ * CO2 calibration, pressure and altitude
+ */
+static void TestCO2(SEN6x &s)
+{
+  uint16_t val = 400;
+  bool asc;
+
+  CHECK(s.ForceCO2Recal(&val) == SEN6x_ERR_OK);
+  CHECK(val == (uint16_t) (400 - 612 + 0x8000));
+
+  CHECK(s.GetCo2SelfCalibratrion(&asc) == SEN6x_ERR_OK && asc);
+  CHECK(s.SetCo2SelfCalibratrion(false) == SEN6x_ERR_OK);
+  s.ClearCache();
+  CHECK(s.GetCo2SelfCalibratrion(&asc) == SEN6x_ERR_OK && ! asc);
+
+  CHECK(s.SetAmbientPressure(950) == SEN6x_ERR_OK);
+  s.ClearCache();
+  CHECK(s.GetAmbientPressure(&val) == SEN6x_ERR_OK && val == 950);
+
+  CHECK(s.SetAltitude(300) == SEN6x_ERR_OK);
+  s.ClearCache();
+  CHECK(s.GetAltitude(&val) == SEN6x_ERR_OK && val == 300);
+}
+
+/**
+ * temperature compensation and acceleration (the simulator checks the
+ * CRC of each parameter)
+ */
+static void TestTemp(SEN6x &s)
+{
+  sen6x_tmp_comp tc = {1.5, 0.01, 10, 1};
+  sen6x_RHT_comp ta = {10, 20, 30, 40};
+
+  CHECK(s.SetTmpComp(&tc) == SEN6x_ERR_OK);
+  CHECK(s.SetTempAccelMode(&ta) == SEN6x_ERR_OK);
+}
+
+/**
+ * injected faults
+ */
+static void TestFaults(SEN6x &s, SEN6xSim &sim, SEN6x_device d)
+{
+  struct sen6x_version v;
+  uint16_t status, expect;
+  uint32_t recovers;
+
+  // without retry each fault is reported, the next command is ok
+  s.SetRetry(0);
+
+  sim.InjectFault(SEN6x_SIM_CRC, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_PROTOCOL);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  sim.InjectFault(SEN6x_SIM_SHORT, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_PROTOCOL);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  sim.InjectFault(SEN6x_SIM_NACK, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_PROTOCOL);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  sim.InjectFault(SEN6x_SIM_STUCK, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_PROTOCOL);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_PROTOCOL);
+  CHECK(s.RecoverBus() == SEN6x_ERR_OK);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  // with retry the faults are masked, a stuck bus is recovered
+  s.SetRetry(SEN6x_RETRIES);
+
+  sim.InjectFault(SEN6x_SIM_CRC, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  sim.InjectFault(SEN6x_SIM_SHORT, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  sim.InjectFault(SEN6x_SIM_NACK, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+
+  recovers = sim.GetRecovers();
+  sim.InjectFault(SEN6x_SIM_STUCK, 1);
+  CHECK(s.GetVersion(&v) == SEN6x_ERR_OK);
+  CHECK(sim.GetRecovers() > recovers);
+
+  // status register
+  expect = (d == SEN60) ? (STATUS_FAN_ERROR_6x | STATUS_SPEED_ERROR_6x) : (STATUS_FAN_ERROR_6x | STATUS_RHT_ERROR_6x);
+  sim.SetStatus(expect);
+  CHECK(s.GetStatusReg(&status) == SEN6x_ERR_OUTOFRANGE);
+  CHECK(status == expect);
+}
+
+/**
+ * SEN6xT<D> decodes the same as SEN6x
+ */
+template<SEN6x_device D>
+static void TestTemplate(void)
+{
+  SEN6xSim sim(D), sim2(D);
+  SEN6xT<D> t;
+  SEN6x s;
+  struct sen6x_values a, b;
+  struct sen6x_concentration_values ca, cb;
+
+  memset(&a, 0x0, sizeof(a));
+  memset(&b, 0x0, sizeof(b));
+  memset(&ca, 0x0, sizeof(ca));
+  memset(&cb, 0x0, sizeof(cb));
+
+  CHECK(t.begin(&sim));
+  CHECK(s.begin(&sim2));
+
+  CHECK(t.GetValues(&a) == SEN6x_ERR_OK);
+  CHECK(s.GetValues(&b) == SEN6x_ERR_OK);
+  CHECK(memcmp(&a, &b, sizeof(a)) == 0);
+
+  CHECK(t.GetConcentration(&ca) == SEN6x_ERR_OK);
+  CHECK(s.GetConcentration(&cb) == SEN6x_ERR_OK);
+  CHECK(memcmp(&ca, &cb, sizeof(ca)) == 0);
+}
+
+/**
+ * the Linux i2c-dev transport with a user-space stand-in
+ */
+static void TestLinux(void)
+{
+  SEN6xSim sim(SEN66);
+  SEN6xSimI2C bus(&sim);
+  SEN6x s;
+  struct sen6x_values v;
+  bool detected;
+
+  CHECK(s.begin(&bus));
+  CHECK(s.GetDevice(&detected) == SEN66 && detected);
+  CHECK(s.GetValues(&v) == SEN6x_ERR_OK);
+  CHECK(v.CO2 == 612);
+  CHECK(sim.GetReads() > 0 && sim.GetWrites() > 0);
+}
+
+int main(void)
+{
+  int d, f;
+
+  for (d = SEN60; d <= SEN68; d++) {
+    SEN6xSim sim((SEN6x_device) d);
+    SEN6x s;
+
+    printf("%s\n", Names[d]);
+    f = Fails;
+
+    CHECK(s.begin(&sim));
+
+    TestInfo(s, (SEN6x_device) d);
+    TestValues(s, (SEN6x_device) d);
+    if (HasXox((SEN6x_device) d)) TestXox(s);
+    if (HasCO2((SEN6x_device) d)) TestCO2(s);
+    if (d != SEN60) TestTemp(s);
+    TestFaults(s, sim, (SEN6x_device) d);
+
+    CHECK(s.reset());
+    CHECK(! sim.IsMeasuring());
+
+    printf("  %s\n", Fails == f ? "ok" : "FAILED");
+  }
+
+  printf("SEN6xT\n");
+  f = Fails;
+  TestTemplate<SEN60>();
+  TestTemplate<SEN63C>();
+  TestTemplate<SEN65>();
+  TestTemplate<SEN66>();
+  TestTemplate<SEN68>();
+  printf("  %s\n", Fails == f ? "ok" : "FAILED");
+
+  printf("Linux i2c-dev stand-in\n");
+  f = Fails;
+  TestLinux();
+  printf("  %s\n", Fails == f ? "ok" : "FAILED");
+
+  printf("%d check(s) failed\n", Fails);
+
+  return(Fails);
+}
@@ -6,153 +6,183 @@
  *
  * Version DRAFT 1.5 / December 2024 /paulvha
  * - updated version
+ *
+ * Version 1.11 / October 2026 / paulvha
+ * - added execution time for each command
+ * - struct sen6x_command moved to sen6x.h
+ * - table is constexpr, used at compile time by SEN6xT (sen6x_template.h)
+ * - table is in flash on AVR, read with SEN6x_OPCODE() and SEN6x_EXECTIME()
+ * - one copy for run time in sen6x_tables.cpp
  */
+#ifndef SEN6x_COMMANDS_H
+#define SEN6x_COMMANDS_H
 
 #include <sen6x.h>
 
 /**
- * Contains the OpCodes for the commands for each sensor
+ * Contains the OpCodes and execution time for the commands for each sensor
  *
  * if the opcode is 0x0000 the command is not supported by the sensor
  *
+ * The execution times are taken from the SEN6x datasheet. The SEN60
+ * datasheet does not provide them, the SEN6x values are used (except
+ * for reset which remains the previous 100mS)
+ *
  * KEEP IN SYNC WITH Sen6x_Comds_offset !!
+ *
+ * SEN6xCommandTable is ONLY for constant expressions (SEN6xT, static_assert),
+ * then no copy is stored. At run time use SEN6x_OPCODE() and SEN6x_EXECTIME(),
+ * they read the one copy SEN6xCommands (in flash on AVR).
  */
-uint16_t SEN6xCommandOpCode [5][SEN6x_GET_SET_ALTITUDE +1] =
-{
+struct sen6x_commands {
+  struct sen6x_command cmd[5][SEN6x_GET_SET_ALTITUDE +1];
+};
+
+constexpr struct sen6x_commands SEN6xCommandTable =
+{{
   /** SEN60 **/
   {
-    0x2152, // SEN6x_START_MEASUREMENT
-    0x3f86, // SEN6x_STOP_MEASUREMENT
-    0xE4B8, // SEN6x_READ_DATA_RDY_FLAG
-    0xEC05, // SEN6x_READ_MEASURED_VALUE
-    0x0000, // SEN6x_READ_RAW_VALUE
-    0x0000, // SEN6x_NUM_CONC_VALUES
-    0x0000, // SEN6x_TEMP_OFFSET
-    0x0000, // SEN6x_TEMP_ACC_PARAM
-    0x0000, // SEN6x_READ_PRODUCT_NAME
-    0x3682, // SEN6x_READ_SERIAL_NUMBER
-    0xD100, // SEN6x_READ_VERSION
-    0xE00B, // SEN6x_READ_DEVICE_REGISTER
-    0x0000, // SEN6x_RD_CL_DEVICE_REGISTER
-    0x3F8D, // SEN6x_RESET
-    0x3730, // SEN6x_START_FAN_CLEANING
-    0x0000, // SEN6x_ACTIVATE_SHT_HEATER
-    0x0000, // SEN6x_GET_SET_VOC_TUNING
-    0x0000, // SEN6x_GET_SET_VOC_STATE
-    0x0000, // SEN6x_GET_SET_NOX_TUNING
-    0x0000, // SEN6x_FORCE_C02_CAL
-    0x0000, // SEN6x_GET_SET_C02_CAL
-    0x0000, // SEN6x_GET_SET_AMBIENT_PRESS
-    0x0000  // SEN6x_GET_SET_ALTITUDE
+    {0x2152,   50}, // SEN6x_START_MEASUREMENT
+    {0x3f86, 1000}, // SEN6x_STOP_MEASUREMENT
+    {0xE4B8,   20}, // SEN6x_READ_DATA_RDY_FLAG
+    {0xEC05,   20}, // SEN6x_READ_MEASURED_VALUE
+    {0x0000,    0}, // SEN6x_READ_RAW_VALUE
+    {0x0000,    0}, // SEN6x_NUM_CONC_VALUES
+    {0x0000,    0}, // SEN6x_TEMP_OFFSET
+    {0x0000,    0}, // SEN6x_TEMP_ACC_PARAM
+    {0x0000,    0}, // SEN6x_READ_PRODUCT_NAME
+    {0x3682,   20}, // SEN6x_READ_SERIAL_NUMBER
+    {0xD100,   20}, // SEN6x_READ_VERSION
+    {0xE00B,   20}, // SEN6x_READ_DEVICE_REGISTER
+    {0x0000,    0}, // SEN6x_RD_CL_DEVICE_REGISTER
+    {0x3F8D,  100}, // SEN6x_RESET
+    {0x3730,   20}, // SEN6x_START_FAN_CLEANING
+    {0x0000,    0}, // SEN6x_ACTIVATE_SHT_HEATER
+    {0x0000,    0}, // SEN6x_GET_SET_VOC_TUNING
+    {0x0000,    0}, // SEN6x_GET_SET_VOC_STATE
+    {0x0000,    0}, // SEN6x_GET_SET_NOX_TUNING
+    {0x0000,    0}, // SEN6x_FORCE_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_AMBIENT_PRESS
+    {0x0000,    0} // SEN6x_GET_SET_ALTITUDE
   },
   /** SEN63C **/
   {
-    0x0021, // SEN6x_START_MEASUREMENT
-    0x0104, // SEN6x_STOP_MEASUREMENT
-    0x0202, // SEN6x_READ_DATA_RDY_FLAG
-    0x0471, // SEN6x_READ_MEASURED_VALUE
-    0x0492, // SEN6x_READ_RAW_VALUE
-    0x0316, // SEN6x_NUM_CONC_VALUES
-    0X60B2, // SEN6x_TEMP_OFFSET
-    0X6100, // SEN6x_TEMP_ACC_PARAM
-    0xD014, // SEN6x_READ_PRODUCT_NAME
-    0xD033, // SEN6x_READ_SERIAL_NUMBER
-    0xD100, // SEN6x_READ_VERSION
-    0xD206, // SEN6x_READ_DEVICE_REGISTER
-    0xD210, // SEN6x_RD_CL_DEVICE_REGISTER
-    0xD304, // SEN6x_RESET
-    0x5607, // SEN6x_START_FAN_CLEANING
-    0X6765, // SEN6x_ACTIVATE_SHT_HEATER
-    0X0000, // SEN6x_GET_SET_VOC_TUNING
-    0X0000, // SEN6x_GET_SET_VOC_STATE
-    0X0000, // SEN6x_GET_SET_NOX_TUNING
-    0X6707, // SEN6x_FORCE_C02_CAL
-    0X6711, // SEN6x_GET_SET_C02_CAL
-    0X6720, // SEN6x_GET_SET_AMBIENT_PRESS
-    0X6736 // SEN6x_GET_SET_ALTITUDE
+    {0x0021,   50}, // SEN6x_START_MEASUREMENT
+    {0x0104, 1000}, // SEN6x_STOP_MEASUREMENT
+    {0x0202,   20}, // SEN6x_READ_DATA_RDY_FLAG
+    {0x0471,   20}, // SEN6x_READ_MEASURED_VALUE
+    {0x0492,   20}, // SEN6x_READ_RAW_VALUE
+    {0x0316,   20}, // SEN6x_NUM_CONC_VALUES
+    {0X60B2,   20}, // SEN6x_TEMP_OFFSET
+    {0X6100,   20}, // SEN6x_TEMP_ACC_PARAM
+    {0xD014,   20}, // SEN6x_READ_PRODUCT_NAME
+    {0xD033,   20}, // SEN6x_READ_SERIAL_NUMBER
+    {0xD100,   20}, // SEN6x_READ_VERSION
+    {0xD206,   20}, // SEN6x_READ_DEVICE_REGISTER
+    {0xD210,   20}, // SEN6x_RD_CL_DEVICE_REGISTER
+    {0xD304, 1200}, // SEN6x_RESET
+    {0x5607,   20}, // SEN6x_START_FAN_CLEANING
+    {0X6765, 1300}, // SEN6x_ACTIVATE_SHT_HEATER
+    {0X0000,    0}, // SEN6x_GET_SET_VOC_TUNING
+    {0X0000,    0}, // SEN6x_GET_SET_VOC_STATE
+    {0X0000,    0}, // SEN6x_GET_SET_NOX_TUNING
+    {0X6707,  500}, // SEN6x_FORCE_C02_CAL
+    {0X6711,   20}, // SEN6x_GET_SET_C02_CAL
+    {0X6720,   20}, // SEN6x_GET_SET_AMBIENT_PRESS
+    {0X6736,   20} // SEN6x_GET_SET_ALTITUDE
   },
   /** SEN65 **/
   {
-    0x0021, // SEN6x_START_MEASUREMENT
-    0x0104, // SEN6x_STOP_MEASUREMENT
-    0x0202, // SEN6x_READ_DATA_RDY_FLAG
-    0x0446, // SEN6x_READ_MEASURED_VALUE
-    0x0455, // SEN6x_READ_RAW_VALUE
-    0x0316, // SEN6x_NUM_CONC_VALUES
-    0X60B2, // SEN6x_TEMP_OFFSET
-    0X6100, // SEN6x_TEMP_ACC_PARAM
-    0xD014, // SEN6x_READ_PRODUCT_NAME
-    0xD033, // SEN6x_READ_SERIAL_NUMBER
-    0xD100, // SEN6x_READ_VERSION
-    0xD206, // SEN6x_READ_DEVICE_REGISTER
-    0xD210, // SEN6x_RD_CL_DEVICE_REGISTER
-    0xD304, // SEN6x_RESET
-    0x5607, // SEN6x_START_FAN_CLEANING
-    0X6765, // SEN6x_ACTIVATE_SHT_HEATER
-    0X60d0, // SEN6x_GET_SET_VOC_TUNING
-    0X6181, // SEN6x_GET_SET_VOC_STATE
-    0X60e1, // SEN6x_GET_SET_NOX_TUNING
-    0x0000, // SEN6x_FORCE_C02_CAL
-    0x0000, // SEN6x_GET_SET_C02_CAL
-    0x0000, // SEN6x_GET_SET_AMBIENT_PRESS
-    0x0000  // SEN6x_GET_SET_ALTITUDE
+    {0x0021,   50}, // SEN6x_START_MEASUREMENT
+    {0x0104, 1000}, // SEN6x_STOP_MEASUREMENT
+    {0x0202,   20}, // SEN6x_READ_DATA_RDY_FLAG
+    {0x0446,   20}, // SEN6x_READ_MEASURED_VALUE
+    {0x0455,   20}, // SEN6x_READ_RAW_VALUE
+    {0x0316,   20}, // SEN6x_NUM_CONC_VALUES
+    {0X60B2,   20}, // SEN6x_TEMP_OFFSET
+    {0X6100,   20}, // SEN6x_TEMP_ACC_PARAM
+    {0xD014,   20}, // SEN6x_READ_PRODUCT_NAME
+    {0xD033,   20}, // SEN6x_READ_SERIAL_NUMBER
+    {0xD100,   20}, // SEN6x_READ_VERSION
+    {0xD206,   20}, // SEN6x_READ_DEVICE_REGISTER
+    {0xD210,   20}, // SEN6x_RD_CL_DEVICE_REGISTER
+    {0xD304, 1200}, // SEN6x_RESET
+    {0x5607,   20}, // SEN6x_START_FAN_CLEANING
+    {0X6765, 1300}, // SEN6x_ACTIVATE_SHT_HEATER
+    {0X60d0,   20}, // SEN6x_GET_SET_VOC_TUNING
+    {0X6181,   20}, // SEN6x_GET_SET_VOC_STATE
+    {0X60e1,   20}, // SEN6x_GET_SET_NOX_TUNING
+    {0x0000,    0}, // SEN6x_FORCE_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_AMBIENT_PRESS
+    {0x0000,    0} // SEN6x_GET_SET_ALTITUDE
   },
   /** SEN66
    *
    * not yet implemented SEN66_GET_SHT_HEATER_MEASUREMENTS_CMD_ID = 0x6790,**/
   {
-    0x0021, // SEN6x_START_MEASUREMENT
-    0x0104, // SEN6x_STOP_MEASUREMENT
-    0x0202, // SEN6x_READ_DATA_RDY_FLAG
-    0x0300, // SEN6x_READ_MEASURED_VALUE
-    0x0405, // SEN6x_READ_RAW_VALUE
-    0x0316, // SEN6x_NUM_CONC_VALUES
-    0X60B2, // SEN6x_TEMP_OFFSET
-    0X6100, // SEN6x_TEMP_ACC_PARAM
-    0xD014, // SEN6x_READ_PRODUCT_NAME
-    0xD033, // SEN6x_READ_SERIAL_NUMBER
-    0xD100, // SEN6x_READ_VERSION
-    0xD206, // SEN6x_READ_DEVICE_REGISTER
-    0xD210, // SEN6x_RD_CL_DEVICE_REGISTER
-    0xD304, // SEN6x_RESET
-    0x5607, // SEN6x_START_FAN_CLEANING
-    0X6765, // SEN6x_ACTIVATE_SHT_HEATER
-    0X60d0, // SEN6x_GET_SET_VOC_TUNING
-    0X6181, // SEN6x_GET_SET_VOC_STATE
-    0X60e1, // SEN6x_GET_SET_NOX_TUNING
-    0X6707, // SEN6x_FORCE_C02_CAL
-    0X6711, // SEN6x_GET_SET_C02_CAL
-    0X6720, // SEN6x_GET_SET_AMBIENT_PRESS
-    0X6736  // SEN6x_GET_SET_ALTITUDE
+    {0x0021,   50}, // SEN6x_START_MEASUREMENT
+    {0x0104, 1000}, // SEN6x_STOP_MEASUREMENT
+    {0x0202,   20}, // SEN6x_READ_DATA_RDY_FLAG
+    {0x0300,   20}, // SEN6x_READ_MEASURED_VALUE
+    {0x0405,   20}, // SEN6x_READ_RAW_VALUE
+    {0x0316,   20}, // SEN6x_NUM_CONC_VALUES
+    {0X60B2,   20}, // SEN6x_TEMP_OFFSET
+    {0X6100,   20}, // SEN6x_TEMP_ACC_PARAM
+    {0xD014,   20}, // SEN6x_READ_PRODUCT_NAME
+    {0xD033,   20}, // SEN6x_READ_SERIAL_NUMBER
+    {0xD100,   20}, // SEN6x_READ_VERSION
+    {0xD206,   20}, // SEN6x_READ_DEVICE_REGISTER
+    {0xD210,   20}, // SEN6x_RD_CL_DEVICE_REGISTER
+    {0xD304, 1200}, // SEN6x_RESET
+    {0x5607,   20}, // SEN6x_START_FAN_CLEANING
+    {0X6765, 1300}, // SEN6x_ACTIVATE_SHT_HEATER
+    {0X60d0,   20}, // SEN6x_GET_SET_VOC_TUNING
+    {0X6181,   20}, // SEN6x_GET_SET_VOC_STATE
+    {0X60e1,   20}, // SEN6x_GET_SET_NOX_TUNING
+    {0X6707,  500}, // SEN6x_FORCE_C02_CAL
+    {0X6711,   20}, // SEN6x_GET_SET_C02_CAL
+    {0X6720,   20}, // SEN6x_GET_SET_AMBIENT_PRESS
+    {0X6736,   20} // SEN6x_GET_SET_ALTITUDE
   },
   /** SEN68
    * not yet implemented SEN66_GET_SHT_HEATER_MEASUREMENTS_CMD_ID = 0x6790,**/
   {
-    0x0021, // SEN6x_START_MEASUREMENT
-    0x0104, // SEN6x_STOP_MEASUREMENT
-    0x0202, // SEN6x_READ_DATA_RDY_FLAG
-    0x0467, // SEN6x_READ_MEASURED_VALUE
-    0x0455, // SEN6x_READ_RAW_VALUE
-    0x0316, // SEN6x_NUM_CONC_VALUES
-    0X60B2, // SEN6x_TEMP_OFFSET
-    0X6100, // SEN6x_TEMP_ACC_PARAM
-    0xD014, // SEN6x_READ_PRODUCT_NAME
-    0xD033, // SEN6x_READ_SERIAL_NUMBER
-    0xD100, // SEN6x_READ_VERSION
-    0xD206, // SEN6x_READ_DEVICE_REGISTER
-    0xD210, // SEN6x_RD_CL_DEVICE_REGISTER
-    0xD304, // SEN6x_RESET
-    0x5607, // SEN6x_START_FAN_CLEANING
-    0X6765, // SEN6x_ACTIVATE_SHT_HEATER
-    0X60d0, // SEN6x_GET_SET_VOC_TUNING
-    0X6181, // SEN6x_GET_SET_VOC_STATE
-    0X60e1, // SEN6x_GET_SET_NOX_TUNING
-    0x0000, // SEN6x_FORCE_C02_CAL
-    0x0000, // SEN6x_GET_SET_C02_CAL
-    0x0000, // SEN6x_GET_SET_AMBIENT_PRESS
-    0x0000  // SEN6x_GET_SET_ALTITUDE
+    {0x0021,   50}, // SEN6x_START_MEASUREMENT
+    {0x0104, 1000}, // SEN6x_STOP_MEASUREMENT
+    {0x0202,   20}, // SEN6x_READ_DATA_RDY_FLAG
+    {0x0467,   20}, // SEN6x_READ_MEASURED_VALUE
+    {0x0455,   20}, // SEN6x_READ_RAW_VALUE
+    {0x0316,   20}, // SEN6x_NUM_CONC_VALUES
+    {0X60B2,   20}, // SEN6x_TEMP_OFFSET
+    {0X6100,   20}, // SEN6x_TEMP_ACC_PARAM
+    {0xD014,   20}, // SEN6x_READ_PRODUCT_NAME
+    {0xD033,   20}, // SEN6x_READ_SERIAL_NUMBER
+    {0xD100,   20}, // SEN6x_READ_VERSION
+    {0xD206,   20}, // SEN6x_READ_DEVICE_REGISTER
+    {0xD210,   20}, // SEN6x_RD_CL_DEVICE_REGISTER
+    {0xD304, 1200}, // SEN6x_RESET
+    {0x5607,   20}, // SEN6x_START_FAN_CLEANING
+    {0X6765, 1300}, // SEN6x_ACTIVATE_SHT_HEATER
+    {0X60d0,   20}, // SEN6x_GET_SET_VOC_TUNING
+    {0X6181,   20}, // SEN6x_GET_SET_VOC_STATE
+    {0X60e1,   20}, // SEN6x_GET_SET_NOX_TUNING
+    {0x0000,    0}, // SEN6x_FORCE_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_C02_CAL
+    {0x0000,    0}, // SEN6x_GET_SET_AMBIENT_PRESS
+    {0x0000,    0} // SEN6x_GET_SET_ALTITUDE
   }
-};
+}};
+
+// run time copy of SEN6xCommandTable (sen6x_tables.cpp)
+extern const struct sen6x_commands SEN6xCommands PROGMEM;
+
+#define SEN6xCommandOpCode    (SEN6xCommands.cmd)
+
+// read opcode / execution time of command c for device d at run time
+#define SEN6x_OPCODE(d, c)    SEN6x_READ_WORD(&SEN6xCommandOpCode[d][c].opcode)
+#define SEN6x_EXECTIME(d, c)  SEN6x_READ_WORD(&SEN6xCommandOpCode[d][c].exectime)
 
 // Write helpers
 #define SEN6x_SET_VOC_STATE           0x55FF
@@ -164,3 +194,5 @@ uint16_t SEN6xCommandOpCode [5][SEN6x_GET_SET_ALTITUDE +1] =
 #define SEN6X_SET_SELF_CO2_CAL        0x55F9
 #define SEN6X_SET_AMBIENT_PRESSURE    0x55F8
 #define SEN6X_SET_ALTITUDE            0x55F7
+
+#endif /* SEN6x_COMMANDS_H */
@@ -0,0 +1,307 @@
+/**
+ * This file contains the layout of the received frames for the different
+ * SEN6x sensors and the decoder that uses them.
+ *
+ * Each field in a result structure has an entry :
+ *  offset : offset of the field in the structure
+ *  word   : word in the received frame (SEN6x_L_NONE : not provided)
+ *  type   : scale, signed and how to store (SEN6x_L_xxx)
+ *
+ * A field that is not provided by the sensor is set to 0. A float field
+ * that the sensor reports as invalid (0xFFFF, or 0x7FFF when signed) is
+ * set to NAN. A 16 bit field is stored as received.
+ *
+ * SEN6x_DecodeFixed() uses the same tables for the fixed structures
+ * (sen6x_values_fixed, sen6x_concentration_fixed). These have a 16 bit
+ * field for each entry in the row, in the same order.
+ *
+ * To add a sensor, add a row in each table (and in SEN6xCommandTable).
+ *
+ * SEN6xLayoutTable is ONLY for constant expressions (SEN6xT), then no copy
+ * is stored. At run time SEN6xValuesLayout, SEN6xRawLayout and
+ * SEN6xConcLayout read the one copy SEN6xLayouts in sen6x_tables.cpp (in
+ * flash on AVR).
+ *
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ * - one copy for run time in sen6x_tables.cpp
+ */
+#ifndef SEN6x_LAYOUTS_H
+#define SEN6x_LAYOUTS_H
+
+#include <sen6x.h>
+#include <stddef.h>
+#include <math.h>
+
+// type : scale
+#define SEN6x_L_1       0x00          // value / 1
+#define SEN6x_L_10      0x01          // value / 10
+#define SEN6x_L_100     0x02          // value / 100
+#define SEN6x_L_200     0x03          // value / 200
+#define SEN6x_L_SCALE   0x03
+
+// type : how to decode and store
+#define SEN6x_L_SIGNED  0x04          // received value is signed
+#define SEN6x_L_FLOAT   0x08          // store scaled in float (else 16 bit)
+
+// word : field is not provided by the sensor
+#define SEN6x_L_NONE    0xFF
+
+/**
+ * frame layout entry
+ */
+struct sen6x_field {
+  uint8_t offset;
+  uint8_t word;
+  uint8_t type;
+};
+
+// number of entries in a row
+#define SEN6x_VALUES_FIELDS   15
+#define SEN6x_RAW_FIELDS      5
+#define SEN6x_CONC_FIELDS     5
+
+// entry helpers
+#define SEN6x_V(f, w, t)      {offsetof(struct sen6x_values, f), w, t}
+#define SEN6x_R(f, w, t)      {offsetof(struct sen6x_raw_values, f), w, t}
+#define SEN6x_C(f, w, t)      {offsetof(struct sen6x_concentration_values, f), w, t}
+
+#define SEN6x_PM              (SEN6x_L_FLOAT | SEN6x_L_10)
+#define SEN6x_IDX             (SEN6x_L_FLOAT | SEN6x_L_SIGNED | SEN6x_L_10)
+#define SEN6x_HUM             (SEN6x_L_FLOAT | SEN6x_L_SIGNED | SEN6x_L_100)
+#define SEN6x_TMP             (SEN6x_L_FLOAT | SEN6x_L_SIGNED | SEN6x_L_200)
+#define SEN6x_NO              SEN6x_L_NONE
+
+/**
+ * the layout tables
+ */
+struct sen6x_layouts {
+  struct sen6x_field values[5][SEN6x_VALUES_FIELDS];
+  struct sen6x_field raw[5][SEN6x_RAW_FIELDS];
+  struct sen6x_field conc[5][SEN6x_CONC_FIELDS];
+};
+
+constexpr struct sen6x_layouts SEN6xLayoutTable =
+{
+/**
+ * SEN6x_READ_MEASURED_VALUE => struct sen6x_values
+ *
+ * KEEP IN SYNC WITH SEN6x_device !!
+ */
+{
+  /** SEN60 **/
+  {
+    SEN6x_V(MassPM1, 0, SEN6x_PM),        SEN6x_V(MassPM2, 1, SEN6x_PM),
+    SEN6x_V(MassPM4, 2, SEN6x_PM),        SEN6x_V(MassPM10, 3, SEN6x_PM),
+    SEN6x_V(NumPM0, 4, SEN6x_PM),         SEN6x_V(NumPM1, 5, SEN6x_PM),
+    SEN6x_V(NumPM2, 6, SEN6x_PM),         SEN6x_V(NumPM4, 7, SEN6x_PM),
+    SEN6x_V(NumPM10, 8, SEN6x_PM),        SEN6x_V(Hum, SEN6x_NO, SEN6x_HUM),
+    SEN6x_V(Temp, SEN6x_NO, SEN6x_TMP),   SEN6x_V(VOC, SEN6x_NO, SEN6x_IDX),
+    SEN6x_V(NOX, SEN6x_NO, SEN6x_IDX),    SEN6x_V(CO2, SEN6x_NO, SEN6x_L_1),
+    SEN6x_V(HCHO, SEN6x_NO, SEN6x_PM)
+  },
+
+  /** SEN63C **/
+  {
+    SEN6x_V(MassPM1, 0, SEN6x_PM),        SEN6x_V(MassPM2, 1, SEN6x_PM),
+    SEN6x_V(MassPM4, 2, SEN6x_PM),        SEN6x_V(MassPM10, 3, SEN6x_PM),
+    SEN6x_V(NumPM0, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM1, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM2, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM4, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM10, SEN6x_NO, SEN6x_PM), SEN6x_V(Hum, 4, SEN6x_HUM),
+    SEN6x_V(Temp, 5, SEN6x_TMP),          SEN6x_V(VOC, SEN6x_NO, SEN6x_IDX),
+    SEN6x_V(NOX, SEN6x_NO, SEN6x_IDX),    SEN6x_V(CO2, 6, SEN6x_L_1),
+    SEN6x_V(HCHO, SEN6x_NO, SEN6x_PM)
+  },
+
+  /** SEN65 **/
+  {
+    SEN6x_V(MassPM1, 0, SEN6x_PM),        SEN6x_V(MassPM2, 1, SEN6x_PM),
+    SEN6x_V(MassPM4, 2, SEN6x_PM),        SEN6x_V(MassPM10, 3, SEN6x_PM),
+    SEN6x_V(NumPM0, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM1, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM2, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM4, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM10, SEN6x_NO, SEN6x_PM), SEN6x_V(Hum, 4, SEN6x_HUM),
+    SEN6x_V(Temp, 5, SEN6x_TMP),          SEN6x_V(VOC, 6, SEN6x_IDX),
+    SEN6x_V(NOX, 7, SEN6x_IDX),           SEN6x_V(CO2, SEN6x_NO, SEN6x_L_1),
+    SEN6x_V(HCHO, SEN6x_NO, SEN6x_PM)
+  },
+
+  /** SEN66 **/
+  {
+    SEN6x_V(MassPM1, 0, SEN6x_PM),        SEN6x_V(MassPM2, 1, SEN6x_PM),
+    SEN6x_V(MassPM4, 2, SEN6x_PM),        SEN6x_V(MassPM10, 3, SEN6x_PM),
+    SEN6x_V(NumPM0, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM1, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM2, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM4, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM10, SEN6x_NO, SEN6x_PM), SEN6x_V(Hum, 4, SEN6x_HUM),
+    SEN6x_V(Temp, 5, SEN6x_TMP),          SEN6x_V(VOC, 6, SEN6x_IDX),
+    SEN6x_V(NOX, 7, SEN6x_IDX),           SEN6x_V(CO2, 8, SEN6x_L_1),
+    SEN6x_V(HCHO, SEN6x_NO, SEN6x_PM)
+  },
+
+  /** SEN68 **/
+  {
+    SEN6x_V(MassPM1, 0, SEN6x_PM),        SEN6x_V(MassPM2, 1, SEN6x_PM),
+    SEN6x_V(MassPM4, 2, SEN6x_PM),        SEN6x_V(MassPM10, 3, SEN6x_PM),
+    SEN6x_V(NumPM0, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM1, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM2, SEN6x_NO, SEN6x_PM),  SEN6x_V(NumPM4, SEN6x_NO, SEN6x_PM),
+    SEN6x_V(NumPM10, SEN6x_NO, SEN6x_PM), SEN6x_V(Hum, 4, SEN6x_HUM),
+    SEN6x_V(Temp, 5, SEN6x_TMP),          SEN6x_V(VOC, 6, SEN6x_IDX),
+    SEN6x_V(NOX, 7, SEN6x_IDX),           SEN6x_V(CO2, SEN6x_NO, SEN6x_L_1),
+    SEN6x_V(HCHO, 8, SEN6x_PM)
+  }
+},
+
+/**
+ * SEN6x_READ_RAW_VALUE => struct sen6x_raw_values
+ * (SEN60 does not support the command)
+ */
+{
+  /** SEN60 **/
+  {
+    SEN6x_R(Hum, SEN6x_NO, SEN6x_L_1),    SEN6x_R(Temp, SEN6x_NO, SEN6x_L_1),
+    SEN6x_R(VOC, SEN6x_NO, SEN6x_L_1),    SEN6x_R(NOX, SEN6x_NO, SEN6x_L_1),
+    SEN6x_R(CO2, SEN6x_NO, SEN6x_L_1)
+  },
+
+  /** SEN63C **/
+  {
+    SEN6x_R(Hum, 0, SEN6x_L_1),           SEN6x_R(Temp, 1, SEN6x_L_1),
+    SEN6x_R(VOC, SEN6x_NO, SEN6x_L_1),    SEN6x_R(NOX, SEN6x_NO, SEN6x_L_1),
+    SEN6x_R(CO2, SEN6x_NO, SEN6x_L_1)
+  },
+
+  /** SEN65 **/
+  {
+    SEN6x_R(Hum, 0, SEN6x_L_1),           SEN6x_R(Temp, 1, SEN6x_L_1),
+    SEN6x_R(VOC, 2, SEN6x_L_1),           SEN6x_R(NOX, 3, SEN6x_L_1),
+    SEN6x_R(CO2, SEN6x_NO, SEN6x_L_1)
+  },
+
+  /** SEN66 **/
+  {
+    SEN6x_R(Hum, 0, SEN6x_L_1),           SEN6x_R(Temp, 1, SEN6x_L_1),
+    SEN6x_R(VOC, 2, SEN6x_L_1),           SEN6x_R(NOX, 3, SEN6x_L_1),
+    SEN6x_R(CO2, 4, SEN6x_L_1)
+  },
+
+  /** SEN68 **/
+  {
+    SEN6x_R(Hum, 0, SEN6x_L_1),           SEN6x_R(Temp, 1, SEN6x_L_1),
+    SEN6x_R(VOC, 2, SEN6x_L_1),           SEN6x_R(NOX, 3, SEN6x_L_1),
+    SEN6x_R(CO2, SEN6x_NO, SEN6x_L_1)
+  }
+},
+
+/**
+ * SEN6x_NUM_CONC_VALUES => struct sen6x_concentration_values
+ * (SEN60 : from SEN6x_READ_MEASURED_VALUE)
+ */
+{
+  /** SEN60 **/
+  {
+    SEN6x_C(NumPM0, 4, SEN6x_PM),         SEN6x_C(NumPM1, 5, SEN6x_PM),
+    SEN6x_C(NumPM2, 6, SEN6x_PM),         SEN6x_C(NumPM4, 7, SEN6x_PM),
+    SEN6x_C(NumPM10, 8, SEN6x_PM)
+  },
+
+  /** SEN63C **/
+  {
+    SEN6x_C(NumPM0, 0, SEN6x_PM),         SEN6x_C(NumPM1, 1, SEN6x_PM),
+    SEN6x_C(NumPM2, 2, SEN6x_PM),         SEN6x_C(NumPM4, 3, SEN6x_PM),
+    SEN6x_C(NumPM10, 4, SEN6x_PM)
+  },
+
+  /** SEN65 **/
+  {
+    SEN6x_C(NumPM0, 0, SEN6x_PM),         SEN6x_C(NumPM1, 1, SEN6x_PM),
+    SEN6x_C(NumPM2, 2, SEN6x_PM),         SEN6x_C(NumPM4, 3, SEN6x_PM),
+    SEN6x_C(NumPM10, 4, SEN6x_PM)
+  },
+
+  /** SEN66 **/
+  {
+    SEN6x_C(NumPM0, 0, SEN6x_PM),         SEN6x_C(NumPM1, 1, SEN6x_PM),
+    SEN6x_C(NumPM2, 2, SEN6x_PM),         SEN6x_C(NumPM4, 3, SEN6x_PM),
+    SEN6x_C(NumPM10, 4, SEN6x_PM)
+  },
+
+  /** SEN68 **/
+  {
+    SEN6x_C(NumPM0, 0, SEN6x_PM),         SEN6x_C(NumPM1, 1, SEN6x_PM),
+    SEN6x_C(NumPM2, 2, SEN6x_PM),         SEN6x_C(NumPM4, 3, SEN6x_PM),
+    SEN6x_C(NumPM10, 4, SEN6x_PM)
+  }
+}
+};
+
+// run time copy of SEN6xLayoutTable (sen6x_tables.cpp)
+extern const struct sen6x_layouts SEN6xLayouts PROGMEM;
+
+#define SEN6xValuesLayout     (SEN6xLayouts.values)
+#define SEN6xRawLayout        (SEN6xLayouts.raw)
+#define SEN6xConcLayout       (SEN6xLayouts.conc)
+
+/**
+ * @brief : decode a received frame into a structure
+ *
+ * @param f      : received frame (CRC checked)
+ * @param layout : row of a layout table
+ * @param n      : number of entries in the row
+ * @param s      : structure to store (all fields in the row are set)
+ */
+inline void SEN6x_DecodeFrame(const uint8_t *f, const struct sen6x_field *layout, uint8_t n, void *s)
+{
+  static const uint8_t Scale[4] = {1, 10, 100, 200};
+  uint8_t *d = (uint8_t *) s;
+  uint8_t i, w, type;
+  uint16_t val;
+  float fl;
+
+  for (i = 0; i < n; i++) {
+    w = SEN6x_READ_BYTE(&layout[i].word);
+    type = SEN6x_READ_BYTE(&layout[i].type);
+
+    val = (w == SEN6x_L_NONE) ? 0 : (uint16_t) f[w * 3] << 8 | f[w * 3 + 1];
+
+    if (type & SEN6x_L_FLOAT) {
+
+      if (w == SEN6x_L_NONE) fl = 0;
+      else if (type & SEN6x_L_SIGNED) {
+        if (val == 0x7FFF) fl = NAN;
+        else fl = (int16_t) val / (float) Scale[type & SEN6x_L_SCALE];
+      }
+      else {
+        if (val == 0xFFFF) fl = NAN;
+        else fl = val / (float) Scale[type & SEN6x_L_SCALE];
+      }
+
+      memcpy(d + SEN6x_READ_BYTE(&layout[i].offset), &fl, sizeof(float));
+    }
+    else
+      memcpy(d + SEN6x_READ_BYTE(&layout[i].offset), &val, sizeof(uint16_t));
+  }
+}
+
+/**
+ * @brief : decode a received frame into a fixed structure (no float)
+ *
+ * @param f      : received frame (CRC checked)
+ * @param layout : row of a layout table
+ * @param n      : number of entries in the row
+ * @param s      : structure with a 16 bit field for each entry
+ */
+inline void SEN6x_DecodeFixed(const uint8_t *f, const struct sen6x_field *layout, uint8_t n, void *s)
+{
+  uint8_t *d = (uint8_t *) s;
+  uint8_t i, w;
+  uint16_t val;
+
+  for (i = 0; i < n; i++) {
+    w = SEN6x_READ_BYTE(&layout[i].word);
+
+    val = (w == SEN6x_L_NONE) ? 0 : (uint16_t) f[w * 3] << 8 | f[w * 3 + 1];
+
+    memcpy(d + i * sizeof(uint16_t), &val, sizeof(uint16_t));
+  }
+}
+
+#endif /* SEN6x_LAYOUTS_H */
@@ -25,17 +25,39 @@
  *
  * Version DRAFT 1.10 / January 2026 / paulvha
  * - updated to support UNOQ
+ *
+ * Version 1.11 / October 2026 / paulvha
+ * - added split-phase (non-blocking) transaction engine
+ * - all reading routines are now using the transaction engine
+ * - wait the execution time of each command as in the datasheet
+ * - all communication is done with a transport (sen6x_transport.h)
+ * - can be build on a Linux host with i2c-dev (sen6x_linux.h)
+ * - fixed DetectDevice(), CRC in SetTmpComp() and SetTempAccelMode()
+ * - fixed stdInitial check in SetVocAlgorithm() and FWCheck()
+ * - added configurable I2C clock with automatic fallback
+ * - table driven CRC, received frame is checked in one pass
+ * - measured, raw and concentration values are decoded straight from
+ *   the received frame (no copy, no memset)
+ * - one decoder driven by the frame layout of each sensor (Sen6xLayouts.h)
+ * - added GetSnapshot() to read all results of one cycle
+ * - added GetValuesFixed() and GetConcentrationFixed() (no float)
+ * - added beginConfig() / commit()
+ * - volatile configuration is cached (shadow), ClearCache()
+ * - added error SEN6x_ERR_STORAGE
+ * - added GetMeta() and SetTimeSource()
+ * - added driver statistics (SEN6x_STATISTICS)
+ * - added retry with backoff and I2C bus recovery
  *********************************************************************
  */
 
 #include "sen6x.h"
 #include "Sen6xCommands.h"
+#include "Sen6xLayouts.h"
 #include <stdarg.h>
 #include <stdio.h>
 
-#if not defined SMALLFOOTPRINT
 /* error descripton */
-struct SEN6x_Description SEN6x_ERR_desc[11] =
+static const struct SEN6x_Description SEN6x_ERR_desc[12] PROGMEM =
 {
   {SEN6x_ERR_OK, "All good"},
   {SEN6x_ERR_DATALENGTH, "Wrong data length for this command (too much or little data)"},
@@ -46,10 +68,10 @@ struct SEN6x_Description SEN6x_ERR_desc[11] =
   {SEN6x_ERR_CMDSTATE, "Command not allowed in current state"},
   {SEN6x_ERR_TIMEOUT, "No response received within timeout period"},
   {SEN6x_ERR_PROTOCOL, "Protocol error"},
+  {SEN6x_ERR_STORAGE, "Storage read or write error"},
   {SEN6x_ERR_FIRMWARE, "Not supported on this SEN6x firmware level"},
   {0xff, "Unknown Error"}
 };
-#endif // SMALLFOOTPRINT
 
 #define DBPRINT DebugPrintf
 #if defined ARDUINO_ARCH_ZEPHYR  // 1.10
@@ -60,6 +82,13 @@ struct SEN6x_Description SEN6x_ERR_desc[11] =
 #define DBPRINT2 DebugPrintf
 #endif
 
+// driver statistics, no code without SEN6x_STATISTICS
+#if defined SEN6x_STATISTICS
+#define SEN6x_STAT(...) __VA_ARGS__
+#else
+#define SEN6x_STAT(...)
+#endif
+
 
 /**
  * @brief constructor and initialize variables
@@ -70,10 +99,36 @@ SEN6x::SEN6x(void)
   _Receive_BUF_Length = 0;
   _Debug = 0;
   _started = false;
+  _config = _configRestart = false;
+  _Shadow.valid = 0;
   _FW_Major = _FW_Minor = 0;
   _device = DEFAULTDEVICE;
   _deviceDetected = false;    // wat auto detected ?
+#if not defined SEN6x_HOST
   _i2cPort = NULL;            // in case no begin was done
+#endif
+  _transport = NULL;
+  _TransState = SEN6x_TRANS_IDLE;
+  _TransResult = SEN6x_ERR_OK;
+  _TransReq = SEN6x_START_MEASUREMENT;
+  _TransRaw = false;
+  _TransSubmit = 0;
+  _TransTry = 0;
+  _TransResend = false;
+  _Retries = SEN6x_RETRIES;
+  _Backoff = SEN6x_BACKOFF;
+  _Clock = SEN6x_CLOCK_STANDARD;
+  _ClkErrors = _ClkReads = 0;
+  _ClkMaxErrors = SEN6x_FALLBACK_ERRORS;
+  _ClkWindow = SEN6x_FALLBACK_WINDOW;
+  _TimeSrc = millis;
+  _TimeRate = 1000;
+  _TimeSent = _MetaReady = 0;
+  _MetaState = SEN6x_RDY_UNKNOWN;
+  _MetaFirst = true;
+  memset(&_Meta, 0x0, sizeof(struct sen6x_meta));
+  _Meta.age = SEN6x_META_UNKNOWN;
+  SEN6x_STAT(memset(&_Stats, 0x0, sizeof(struct sen6x_statistics)));
 }
 
 ////////////////////// general routines  //////////////////////
@@ -85,6 +140,7 @@ SEN6x::SEN6x(void)
 void SEN6x::SetDevice(SEN6x_device d) {
   _device = d;
   _deviceDetected = false;
+  ClearCache();                 // cache belongs to the previous device
 }
 
 uint8_t SEN6x::GetDevice(bool *detected)
@@ -116,10 +172,40 @@ void SEN6x::EnableDebugging(uint8_t act)
  *  true : if SEN6x sensor type was identified
  * false : if not able
  */
+#if not defined SEN6x_HOST
 bool SEN6x::begin(TwoWire *wirePort)
 {
   _i2cPort = wirePort;            // Grab which port the user wants us to use
-  _i2cPort->setClock(100000);     // some boards do not set 100K
+
+  // clock is set in begin(transport), some boards do not set 100K
+  _TwoWire.SetPort(_i2cPort);
+
+  return(begin(&_TwoWire));
+}
+#endif // SEN6x_HOST
+
+/**
+ * @brief begin communication
+ *
+ * @param transport : transport to be used
+ *
+ * User must have initialized the transport in the sketch.
+ *
+ * @return
+ *  true : if SEN6x sensor type was identified
+ * false : if not able
+ */
+bool SEN6x::begin(SEN6xTransport *transport)
+{
+  _transport = transport;
+
+  // not all transports can set the clock
+  _transport->setClock(_Clock);
+  _ClkErrors = _ClkReads = 0;
+  SEN6x_STAT(ClearStatistics());
+
+  // could be another sensor than before
+  ClearCache();
 
   // try detect the device by device name
   // (NOT ABLE TO TEST, wait for NON-pre-release version..)
@@ -143,41 +229,28 @@ bool SEN6x::probe()
   return(false);
 }
 
+/**
+ * The waiting time for the command to execute on the device is handled
+ * by the transaction engine (see CommandWait()). The transaction engine
+ * will also update _started.
+ */
 bool SEN6x::reset()
 {
-  if (! SendCommand(SEN6x_RESET)) return(false);
-
-  _started = false;
-
-  delay(100);            // needs at least 20ms, we give plenty of time
-
-  return(true);
+  return(SendCommand(SEN6x_RESET));
 }
 
 bool SEN6x::start()
 {
   if (_started) return(true);
 
-  if (! SendCommand(SEN6x_START_MEASUREMENT)) return(false);
-
-  _started = true;
-
-  delay(100);            // needs at least 50ms, we give plenty of time
-
-  return(true);
+  return(SendCommand(SEN6x_START_MEASUREMENT));
 }
 
 bool SEN6x::stop()
 {
   if (! _started) return(true);
 
-  if (! SendCommand(SEN6x_STOP_MEASUREMENT)) return(false);
-
-  delay(1000);          // give time to stop
-
-  _started = false;
-
-  return(true);
+  return(SendCommand(SEN6x_STOP_MEASUREMENT));
 }
 
 /**
@@ -206,6 +279,52 @@ bool SEN6x::clean()
   return(SendCommand(SEN6x_START_FAN_CLEANING));
 }
 
+/**
+ * @brief stop the measurement once for a number of configuration calls
+ *
+ * While the measurement is stopped CheckToStop() and CheckWasStarted()
+ * have nothing to do, so the configuration calls are executed back to
+ * back.
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6x::beginConfig()
+{
+  if (_config) return(SEN6x_ERR_CMDSTATE);
+
+  _configRestart = _started;
+
+  if (! stop()) {
+    DBPRINT("ERROR: Could not stop measurement\r\n");
+    return(SEN6x_ERR_PROTOCOL);
+  }
+
+  _config = true;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief end of configuration calls, restart measurement if it was running
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6x::commit()
+{
+  if (! _config) return(SEN6x_ERR_CMDSTATE);
+
+  _config = false;
+  _restart = _configRestart;
+
+  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+  return(SEN6x_ERR_OK);
+}
+
 /**
  * @brief Check Firmware level
  *
@@ -225,7 +344,8 @@ bool SEN6x::FWCheck(uint8_t major, uint8_t minor)
   if (_FW_Major == 0)  if (! probe()) return (false);
 
   // if requested level is HIGHER than current
-  if (major > _FW_Major || minor > _FW_Minor) return(false);
+  if (major > _FW_Major) return(false);
+  if (major == _FW_Major && minor > _FW_Minor) return(false);
 
   return(true);
 }
@@ -246,7 +366,7 @@ bool SEN6x::FWCheck(uint8_t major, uint8_t minor)
 bool SEN6x::DetectDevice()
 {
   char Dtmp[32];
-  char needle[5];
+  char needle[6];
 
   // get the name (all except SEN60)
   if (GetProductName(Dtmp, 32) != SEN6x_ERR_OK) {
@@ -275,7 +395,8 @@ bool SEN6x::DetectDevice()
 
   // not sure name is SEN63 or SEN63C, so only take first 5 characters
   // TO be corrected later
-  strncpy(needle,(char*) _Receive_BUF,5);
+  strncpy(needle, Dtmp, 5);
+  needle[5] = 0x0;
 
   if (strcmp(needle,"SEN63") == 0) {_device = SEN63; return(true);}
   else if (strcmp(needle,"SEN65") == 0) {_device = SEN65; return(true);}
@@ -304,7 +425,7 @@ uint8_t SEN6x::GetVersion(struct sen6x_version *v)
 
   if (! SetCommand(SEN6x_READ_VERSION)) return(SEN6x_ERR_UNKNOWNCMD);
 
-  ret = I2C_SetPointer_Read(8);
+  ret = I2C_SetPointer_Read(SEN6x_READ_VERSION, ReadLength(SEN6x_READ_VERSION));
 
   if( ret  == SEN6x_ERR_OK) {
     v->F_major = _Receive_BUF[0];
@@ -345,9 +466,10 @@ uint8_t SEN6x::GetProductName(char *ser, uint8_t len)
 
     // NO command to obtain productname for SEN60
     if(_device == SEN60) {
-      for (i = 0; i < len, i < strlen(s60); i++) {
+      for (i = 0; i < len - 1 && i < strlen(s60); i++) {
         ser[i] = s60[i];
       }
+      ser[i] = 0x0;
       return SEN6x_ERR_OK;
     }
     else // who knows in the future ??
@@ -355,7 +477,7 @@ uint8_t SEN6x::GetProductName(char *ser, uint8_t len)
   }
 
   // true = check zero termination
-  ret =  I2C_SetPointer_Read(len,true);
+  ret =  I2C_SetPointer_Read(SEN6x_READ_PRODUCT_NAME, len, true);
 
   if (ret == SEN6x_ERR_OK) {
 
@@ -387,7 +509,7 @@ uint8_t SEN6x::GetSerialNumber(char *ser, uint8_t len)
   if (! SetCommand(SEN6x_READ_SERIAL_NUMBER)) return(SEN6x_ERR_UNKNOWNCMD);
 
   // true = check zero termination
-  ret =  I2C_SetPointer_Read(len,true);
+  ret =  I2C_SetPointer_Read(SEN6x_READ_SERIAL_NUMBER, len, true);
 
   if (ret == SEN6x_ERR_OK) {
 
@@ -432,23 +554,43 @@ uint8_t SEN6x::GetStatusReg(uint16_t *status)
   // check for minimum Firmware level ???????
   if(! FWCheck(2,0)) return(SEN6x_ERR_FIRMWARE);
 
-  if (! SetCommand(SEN6x_READ_DEVICE_REGISTER)) return(SEN6x_ERR_UNKNOWNCMD);
+  ret = submit(SEN6x_READ_DEVICE_REGISTER);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
+  if (ret != SEN6x_ERR_OK) return(ret);
 
-  if (_device == SEN60 ){
+  return(ParseStatusReg(status));
+}
+
+/**
+ * @brief decode status register from completed transaction
+ *
+ * @param  *status : see GetStatusReg()
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok, no isues found
+ *  SEN6x_ERR_OUTOFRANGE, ERROR status feedback
+ *  SEN6x_ERR_CMDSTATE, no completed status transaction
+ */
+uint8_t SEN6x::ParseStatusReg(uint16_t *status)
+{
+  uint8_t ret;
 
-    ret = I2C_SetPointer_Read(2);
+  *status = STATUS_OK_6x;
+
+  if (_TransReq == SEN6x_RD_CL_DEVICE_REGISTER)
+    ret = TransCheck(SEN6x_RD_CL_DEVICE_REGISTER);
+  else
+    ret = TransCheck(SEN6x_READ_DEVICE_REGISTER);
 
-    if (ret != SEN6x_ERR_OK) return (ret);
+  if (ret != SEN6x_ERR_OK) return (ret);
 
+  if (_device == SEN60 ){
     if (_Receive_BUF[1] & 0b00000010) *status |= STATUS_SPEED_ERROR_6x;
     if (_Receive_BUF[1] & 0b00010000) *status |= STATUS_FAN_ERROR_6x;
   }
 
   else {
 
-    ret = I2C_SetPointer_Read(4);
-    if (ret != SEN6x_ERR_OK) return (ret);
-
     if (_Receive_BUF[1] & 0b00100000) *status |= STATUS_SPEED_ERROR_6x;
 
     if (_Receive_BUF[2] & 0b00000010) *status |= STATUS_CO2_2_ERROR_6x;
@@ -475,17 +617,43 @@ uint8_t SEN6x::GetStatusReg(uint16_t *status)
  */
 bool SEN6x::CheckDataReady()
 {
+  bool ready = false;
+
   // make sure started
   _restart = ! _started;
-  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+  if (! CheckWasStarted()) return(false);
 
-  if (! SetCommand(SEN6x_READ_DATA_RDY_FLAG)) return(false);
+  if (submit(SEN6x_READ_DATA_RDY_FLAG) != SEN6x_ERR_OK) return(false);
 
-  if (I2C_SetPointer_Read(2) != SEN6x_ERR_OK) return(false);
+  if (I2C_Wait() != SEN6x_ERR_OK) return(false);
 
-  if (_Receive_BUF[1] == 1) return(true);
+  ParseDataReady(&ready);
 
-  return(false);
+  return(ready);
+}
+
+/**
+ * @brief : decode data ready from completed transaction
+ *
+ * @param ready :
+ *  true  if available
+ *  false if not
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6x::ParseDataReady(bool *ready)
+{
+  uint8_t ret;
+
+  *ready = false;
+
+  ret = TransCheck(SEN6x_READ_DATA_RDY_FLAG);
+
+  if (ret == SEN6x_ERR_OK) *ready = (_Receive_BUF[1] == 1);
+
+  return(ret);
 }
 
 /**
@@ -501,57 +669,45 @@ bool SEN6x::CheckDataReady()
  */
 uint8_t SEN6x::GetValues(struct sen6x_values *v)
 {
-  uint8_t ret, len;
-
-  memset(v,0x0,sizeof(struct sen6x_values));
+  uint8_t ret;
 
   // make sure started
   _restart = ! _started;
-  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
-
-  if (! SetCommand(SEN6x_READ_MEASURED_VALUE)) return(SEN6x_ERR_UNKNOWNCMD);
-
-  if (_device == SEN60 )     len = 18;
-  else if(_device == SEN63C) len = 14;
-  else if(_device == SEN65 ) len = 16;
-  else if(_device == SEN66 ) len = 18;
-  else len = 18;
-
-  ret = I2C_SetPointer_Read(len);
+  if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+  else ret = submit(SEN6x_READ_MEASURED_VALUE);
 
-  if (ret != SEN6x_ERR_OK) return (ret);
-
-  // get data
-  v->MassPM1 = (float)((byte_to_Uint16_t(0)) / (float) 10);
-  v->MassPM2 = (float)((byte_to_Uint16_t(2)) / (float) 10);
-  v->MassPM4 = (float)((byte_to_Uint16_t(4)) / (float) 10);
-  v->MassPM10 =(float)((byte_to_Uint16_t(6)) / (float) 10);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
 
-  if (_device == SEN60 ){
-    v->NumPM0 =  (float)((byte_to_Uint16_t(8)) / (float) 10);
-    v->NumPM1 =  (float)((byte_to_Uint16_t(10)) / (float) 10);
-    v->NumPM2 =  (float)((byte_to_Uint16_t(12)) / (float) 10);
-    v->NumPM4 =  (float)((byte_to_Uint16_t(14)) / (float) 10);
-    v->NumPM4 =  (float)((byte_to_Uint16_t(14)) / (float) 10);
-    v->NumPM10 = (float)((byte_to_Uint16_t(16)) / (float) 10);
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_values));
+    return(ret);
   }
 
-  else { // SEN63C, SEN65, SEN66, SEN68
-    v->Hum =  (float)((byte_to_int16_t(8)) / (float) 100);       // Compensated Ambient Humidity [%RH]
-    v->Temp = (float)((byte_to_int16_t(10)) / (float) 200);      // Compensated Ambient Temperature [°C]
-
-    if (_device == SEN63C)  v->CO2 =  byte_to_Uint16_t(12);      // CO2
+  return(ParseValues(v));
+}
 
-    else {      // SEN65, SEN66, SEN68
-      v->VOC =  (float)((byte_to_int16_t(12)) / (float) 10);     // VOC Index
-      v->NOX =  (float)((byte_to_int16_t(14)) / (float) 10);     // NOx Index
+/**
+ * @brief : decode values from completed transaction
+ *
+ * @param v: pointer to structure to store
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6x::ParseValues(struct sen6x_values *v)
+{
+  uint8_t ret;
 
-      if (_device == SEN66 ) v->CO2 =  (float) byte_to_Uint16_t(16);     // CO2
+  ret = TransCheck(SEN6x_READ_MEASURED_VALUE);
 
-      if (_device == SEN68 ) v->HCHO = (float)((byte_to_Uint16_t(16)) / (float) 10); // HCHO (formaldehyde)
-    }
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_values));
+    return (ret);
   }
 
+  SEN6x_DecodeFrame(_Receive_BUF, SEN6xValuesLayout[_device], SEN6x_VALUES_FIELDS, v);
+
   return(SEN6x_ERR_OK);
 }
 
@@ -563,40 +719,47 @@ uint8_t SEN6x::GetValues(struct sen6x_values *v)
  */
 uint8_t SEN6x::GetRawValues(struct sen6x_raw_values *v)
 {
-  uint8_t ret, len;
-
-  memset(v,0x0,sizeof(struct sen6x_raw_values));
+  uint8_t ret;
 
   // first check the sensor type supports rawvalues (SEN60 does NOT)
   uint16_t cmnd  = LookupCommand(SEN6x_READ_RAW_VALUE);
-  if (cmnd == 0x0000 ) return(SEN6x_ERR_UNKNOWNCMD);
+  if (cmnd == 0x0000 ) ret = SEN6x_ERR_UNKNOWNCMD;
 
   // make sure started
-  _restart = ! _started;
-  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+  else {
+    _restart = ! _started;
+    if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+    else ret = submit(SEN6x_READ_RAW_VALUE);
+  }
 
-  if(_device == SEN63C)     len = 4;
-  else if(_device == SEN65) len = 8;
-  else if(_device == SEN66) len = 10;
-  else len = 8;
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
 
-  I2C_fill_buffer(cmnd);
-  ret = I2C_SetPointer_Read(len);
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_raw_values));
+    return(ret);
+  }
 
-  if (ret != SEN6x_ERR_OK) return (ret);
+  return(ParseRawValues(v));
+}
 
-  v->Hum =  byte_to_int16_t(0);      // Compensated Ambient Humidity [%RH]
-  v->Temp = byte_to_int16_t(2);      // Compensated Ambient Temperature [°C]
+/**
+ * @brief : decode RAW values from completed transaction
+ *
+ * Applies to: SEN63C, SEN65, SEN66, SEN68
+ */
+uint8_t SEN6x::ParseRawValues(struct sen6x_raw_values *v)
+{
+  uint8_t ret;
 
-  if (_device != SEN63C) {  // SEN65, SEN66, SEN68
-    v->VOC =  byte_to_Uint16_t(4);   // VOC Index
-    v->NOX =  byte_to_Uint16_t(6);   // NOx Index
+  ret = TransCheck(SEN6x_READ_RAW_VALUE);
 
-    if (_device == SEN66 ) {
-      v->CO2 =  byte_to_Uint16_t(8); // CO2
-    }
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_raw_values));
+    return (ret);
   }
 
+  SEN6x_DecodeFrame(_Receive_BUF, SEN6xRawLayout[_device], SEN6x_RAW_FIELDS, v);
+
   return(SEN6x_ERR_OK);
 }
 
@@ -605,157 +768,408 @@ uint8_t SEN6x::GetRawValues(struct sen6x_raw_values *v)
  */
 uint8_t SEN6x::GetConcentration(struct sen6x_concentration_values *v)
 {
-  uint8_t ret, len, offset;
-
-  memset(v,0x0,sizeof(struct sen6x_concentration_values));
+  uint8_t ret;
 
   // make sure started
   _restart = ! _started;
-  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+  if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
 
   // for SEN60 it is in SEN6x_READ_MEASURED_VALUE
-  if (_device == SEN60 ) {
-    if (! SetCommand(SEN6x_READ_MEASURED_VALUE)) return(SEN6x_ERR_UNKNOWNCMD);
-    len = 18;
-    offset = 8;
-  }
-  else {
-    if (! SetCommand(SEN6x_NUM_CONC_VALUES)) return(SEN6x_ERR_UNKNOWNCMD);
-    len = 10;
-    offset = 0;
-  }
+  else if (_device == SEN60 ) ret = submit(SEN6x_READ_MEASURED_VALUE);
+  else ret = submit(SEN6x_NUM_CONC_VALUES);
 
-  ret = I2C_SetPointer_Read(len);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
 
-  if (ret == SEN6x_ERR_OK) {
-    v->NumPM0 =  (float)((byte_to_Uint16_t(offset)) / (float) 10);
-    v->NumPM1 =  (float)((byte_to_Uint16_t(offset + 2)) / (float) 10);
-    v->NumPM2 =  (float)((byte_to_Uint16_t(offset + 4)) / (float) 10);
-    v->NumPM4 =  (float)((byte_to_Uint16_t(offset + 6)) / (float) 10);
-    v->NumPM10 = (float)((byte_to_Uint16_t(offset + 8)) / (float) 10);
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_concentration_values));
+    return(ret);
   }
 
-  return (ret);
+  return(ParseConcentration(v));
 }
 
-///////////////////////// SH & T related routines /////////////
-//************************************************************/
 /**
- * Applies to: SEN63C, SEN65, SEN66, SEN68
- *
- * @brief : This command allows to set custom temperature acceleration
- * parameters of the RH/T engine. It overwrites the default temperature
- * acceleration parameters of the RH/T engine with custom values.
- * This configuration is volatile, i.e. the parameters will be reverted
- * to their default values after a device reset.
- *
- * For more details on how to compensate the temperature on the SEN6x platform,
- * refer to “Temperature Acceleration and Compensation Instructions for SEN6x” [3].
+ *  @brief decode concentration (the PM numbers) from completed transaction
  */
-uint8_t SEN6x::SetTempAccelMode(sen6x_RHT_comp *table)
+uint8_t SEN6x::ParseConcentration(struct sen6x_concentration_values *v)
 {
   uint8_t ret;
 
-  // CAN NOT be done when measuring
-  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+  // for SEN60 it is in SEN6x_READ_MEASURED_VALUE
+  if (_device == SEN60 ) ret = TransCheck(SEN6x_READ_MEASURED_VALUE);
+  else ret = TransCheck(SEN6x_NUM_CONC_VALUES);
 
-  ret = I2C_fill_buffer(SEN6x_SET_TEMP_ACCEL, table);
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK) SEN6x_DecodeFrame(_Receive_BUF, SEN6xConcLayout[_device], SEN6x_CONC_FIELDS, v);
+  else memset(v,0x0,sizeof(struct sen6x_concentration_values));
 
-  //sensor will be restarted with next value request
-  return(ret);
+  return (ret);
 }
 
 /**
- * Applies to: SEN63C, SEN65, SEN66, SEN68
- * Using the sen5x information for now. (December 2024)
+ * @brief : read values as integers (no float)
  */
-uint8_t SEN6x::SetTmpComp(sen6x_tmp_comp *tmp)
+uint8_t SEN6x::GetValuesFixed(struct sen6x_values_fixed *v)
 {
   uint8_t ret;
-  sen6x_tmp_comp t;
-
-  t.offset = tmp->offset * 200;
-  t.slope = tmp->slope * 1000;
-  t.slot = tmp->slot;
-  t.time = tmp->time;
 
-  // check slot (not clear what this is. awaiting on documentation)???
-  if (t.slot > 4) t.slot  = 4;
+  // make sure started
+  _restart = ! _started;
+  if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+  else ret = submit(SEN6x_READ_MEASURED_VALUE);
 
-  ret = I2C_fill_buffer(SEN6x_SET_TEMP_COMP, &t);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
 
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_values_fixed));
+    return(ret);
+  }
 
-  return(ret);
+  return(ParseValuesFixed(v));
 }
 
 /**
- * Applies to: SEN63C, SEN65, SEN66, SEN68
- *
- *  @brief This command allows you to use the inbuilt heater
- * in SHT sensor to reverse creep at high humidity.
- *
- * This command activates the SHT sensor heater with 200mW for 1s.
- * The heater is then automatically deactivated again.
- *
- * Wait at least 20s after this command before starting a measurement
- * to get coherent temperature values (heating consequence to disappear).
- *
- * No wait is implemented as this can/must be done in the sketch to enable
- * checking other values.
+ * @brief : decode values as integers from completed transaction
  */
-bool SEN6x::ActivateSHTHeater()
+uint8_t SEN6x::ParseValuesFixed(struct sen6x_values_fixed *v)
 {
-  // CAN NOT be done when measuring
-  if (! CheckToStop()) return(false);
+  uint8_t ret;
 
-  bool ret = SendCommand(SEN6x_ACTIVATE_SHT_HEATER);
+  ret = TransCheck(SEN6x_READ_MEASURED_VALUE);
 
-  delay(1300);
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_values_fixed));
+    return (ret);
+  }
 
-  //will be restarted with next value request
-  return(ret);
-}
+  SEN6x_DecodeFixed(_Receive_BUF, SEN6xValuesLayout[_device], SEN6x_VALUES_FIELDS, v);
 
-///////////////////////// VOC related routines ////////////////
-//************************************************************/
+  return(SEN6x_ERR_OK);
+}
 
 /**
- * Applies to: SEN65, SEN66, SEN68
- *
- * @brief Allows backup of the VOC algorithm state to resume
- * operation after a power cycle or device reset, skipping initial learning phase.
- *
- * By default, the VOC Engine is reset, and the algorithm state is retained if a
- * measurement is stopped and started again. If the VOC algorithm state shall be
- * reset, a device reset, or a power cycle can be executed.
- *
- * Gets the current VOC algorithm state. This data can be used to restore the
- * state with Set VOC Algorithm State command after a short power cycle or device reset.
- *
- * This command can be used either in measure mode or in idle mode (which will
- * then return the state at the time when the measurement was stopped).
- * In measure mode, the state can be read each measure interval to always have
- * the latest state available, even in case of a sudden power loss.
+ *  @brief read concentration of the sensor as integers (no float)
  */
-uint8_t SEN6x::GetVocAlgorithmState(uint8_t *table, uint8_t tablesize)
+uint8_t SEN6x::GetConcentrationFixed(struct sen6x_concentration_fixed *v)
 {
   uint8_t ret;
 
-  if (! SetCommand(SEN6x_GET_SET_VOC_STATE)) return(SEN6x_ERR_UNKNOWNCMD);
+  // make sure started
+  _restart = ! _started;
+  if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
 
-  // Check for Voc Algorithm length
-  if (tablesize < VOC_ALO_SIZE) return(SEN6x_ERR_PARAMETER);
+  // for SEN60 it is in SEN6x_READ_MEASURED_VALUE
+  else if (_device == SEN60 ) ret = submit(SEN6x_READ_MEASURED_VALUE);
+  else ret = submit(SEN6x_NUM_CONC_VALUES);
 
-  ret = I2C_SetPointer_Read(VOC_ALO_SIZE);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
 
-  // save VOC data
-  for (int i = 0; i < VOC_ALO_SIZE; i++) {
-    table[i] =_Receive_BUF[i];
+  if (ret != SEN6x_ERR_OK) {
+    memset(v,0x0,sizeof(struct sen6x_concentration_fixed));
+    return(ret);
   }
 
-  return(ret);
+  return(ParseConcentrationFixed(v));
+}
+
+/**
+ *  @brief decode concentration as integers from completed transaction
+ */
+uint8_t SEN6x::ParseConcentrationFixed(struct sen6x_concentration_fixed *v)
+{
+  uint8_t ret;
+
+  // for SEN60 it is in SEN6x_READ_MEASURED_VALUE
+  if (_device == SEN60 ) ret = TransCheck(SEN6x_READ_MEASURED_VALUE);
+  else ret = TransCheck(SEN6x_NUM_CONC_VALUES);
+
+  if (ret == SEN6x_ERR_OK) SEN6x_DecodeFixed(_Receive_BUF, SEN6xConcLayout[_device], SEN6x_CONC_FIELDS, v);
+  else memset(v,0x0,sizeof(struct sen6x_concentration_fixed));
+
+  return (ret);
+}
+
+/**
+ * @brief read values, PM numbers, raw values and status in one go
+ *
+ * The plan only holds the commands the sensor supports. Each next
+ * command is submitted before the answer of the previous one is decoded,
+ * so decoding overlaps with the execution time on the sensor.
+ */
+uint8_t SEN6x::GetSnapshot(struct sen6x_snapshot *s)
+{
+  Sen6x_Comds_offset plan[4];
+  uint8_t n = 0, i, ret;
+
+  memset(s,0x0,sizeof(struct sen6x_snapshot));
+
+  // SEN60 has the PM numbers in the measured values
+  plan[n++] = SEN6x_READ_MEASURED_VALUE;
+  if (LookupCommand(SEN6x_NUM_CONC_VALUES) != 0x0000) plan[n++] = SEN6x_NUM_CONC_VALUES;
+  if (LookupCommand(SEN6x_READ_RAW_VALUE) != 0x0000) plan[n++] = SEN6x_READ_RAW_VALUE;
+  if (FWCheck(2,0)) plan[n++] = SEN6x_READ_DEVICE_REGISTER;
+
+  // make sure started
+  _restart = ! _started;
+  if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+  ret = submit(plan[0]);
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
+
+  for (i = 0; i < n && ret == SEN6x_ERR_OK; i++) {
+
+    // the status register is decoded from the completed transaction
+    if (plan[i] == SEN6x_READ_DEVICE_REGISTER) {
+      ret = ParseStatusReg(&s->status);
+      break;
+    }
+
+    // start next command, _Receive_BUF is kept until it is read
+    if (i + 1 < n) ret = submit(plan[i + 1]);
+
+    if (plan[i] == SEN6x_READ_MEASURED_VALUE) {
+      SEN6x_DecodeFrame(_Receive_BUF, SEN6xValuesLayout[_device], SEN6x_VALUES_FIELDS, &s->values);
+      if (_device == SEN60) SEN6x_DecodeFrame(_Receive_BUF, SEN6xConcLayout[_device], SEN6x_CONC_FIELDS, &s->conc);
+    }
+    else if (plan[i] == SEN6x_NUM_CONC_VALUES)
+      SEN6x_DecodeFrame(_Receive_BUF, SEN6xConcLayout[_device], SEN6x_CONC_FIELDS, &s->conc);
+    else
+      SEN6x_DecodeFrame(_Receive_BUF, SEN6xRawLayout[_device], SEN6x_RAW_FIELDS, &s->raw);
+
+    if (i + 1 < n && ret == SEN6x_ERR_OK) ret = I2C_Wait();
+  }
+
+  if (ret != SEN6x_ERR_OK && ret != SEN6x_ERR_OUTOFRANGE) {
+    memset(s,0x0,sizeof(struct sen6x_snapshot));
+  }
+
+  return(ret);
+}
+
+/**
+ * @brief : metadata of the last measured values read
+ */
+void SEN6x::GetMeta(struct sen6x_meta *m)
+{
+  memcpy(m, &_Meta, sizeof(struct sen6x_meta));
+}
+
+void SEN6x::SetTimeSource(unsigned long (*src)(void), unsigned long rate)
+{
+  _TimeSrc = src;
+  _TimeRate = rate ? rate : 1000;
+  _MetaFirst = true;
+  _MetaState = SEN6x_RDY_UNKNOWN;
+}
+
+/**
+ * @brief : update the metadata from a completed transaction
+ *
+ * The sensor makes a measurement every second. Reading the measured
+ * values resets data ready. The number of measurements since the
+ * previous read :
+ *  - data ready seen     : at least 1
+ *  - not ready seen      : whole seconds since that was seen
+ *  - nothing seen        : seconds since the previous read (rounded)
+ */
+void SEN6x::Meta()
+{
+  unsigned long now = _TimeSrc();
+  uint32_t n;
+
+  switch(_TransReq) {
+
+    case SEN6x_START_MEASUREMENT:
+      _MetaFirst = true;
+      _MetaState = SEN6x_RDY_UNKNOWN;
+      break;
+
+    case SEN6x_READ_DATA_RDY_FLAG:
+      if (_Receive_BUF[1] == 1) {
+        if (_MetaState != SEN6x_RDY_SEEN) {
+          _MetaState = SEN6x_RDY_SEEN;
+          _MetaReady = now;
+        }
+      }
+      else {
+        _MetaState = SEN6x_RDY_NOT;
+        _MetaReady = now;
+      }
+      break;
+
+    case SEN6x_READ_MEASURED_VALUE:
+      if (_MetaState == SEN6x_RDY_NOT)
+        n = (now - _MetaReady) / _TimeRate;
+      else
+        n = (now - _Meta.time + _TimeRate / 2) / _TimeRate;
+
+      if (_MetaFirst || (_MetaState == SEN6x_RDY_SEEN && n == 0)) n = 1;
+
+      _Meta.seq += n;
+      _Meta.age = (_MetaState == SEN6x_RDY_SEEN) ? now - _MetaReady : SEN6x_META_UNKNOWN;
+      _Meta.latency = now - _TimeSent;
+      _Meta.time = now;
+      _MetaFirst = false;
+      _MetaState = SEN6x_RDY_UNKNOWN;
+      break;
+
+    default:
+      break;
+  }
+}
+
+#if defined SEN6x_STATISTICS
+/**
+ * @brief : driver statistics
+ */
+void SEN6x::GetStatistics(struct sen6x_statistics *s)
+{
+  memcpy(s, &_Stats, sizeof(struct sen6x_statistics));
+}
+
+void SEN6x::ClearStatistics()
+{
+  memset(&_Stats, 0x0, sizeof(struct sen6x_statistics));
+}
+
+/**
+ * @brief : count a completed command
+ *
+ * @param req   : command
+ * @param ms    : latency in mS
+ * @param error : command failed
+ */
+void SEN6x::StatCommand(Sen6x_Comds_offset req, unsigned long ms, bool error)
+{
+  static const uint16_t Bounds[SEN6x_LATENCY_BUCKETS] = SEN6x_LATENCY_BOUNDS;
+  struct sen6x_cmd_statistics *c = &_Stats.cmd[req];
+  uint8_t i;
+
+  c->count++;
+  if (error && c->errors < 0xFFFF) c->errors++;
+
+  for (i = 0; i < SEN6x_LATENCY_BUCKETS - 1; i++)
+    if (ms <= Bounds[i]) break;
+
+  if (c->latency[i] < 0xFFFF) c->latency[i]++;
+}
+#endif // SEN6x_STATISTICS
+
+///////////////////////// SH & T related routines /////////////
+//************************************************************/
+/**
+ * Applies to: SEN63C, SEN65, SEN66, SEN68
+ *
+ * @brief : This command allows to set custom temperature acceleration
+ * parameters of the RH/T engine. It overwrites the default temperature
+ * acceleration parameters of the RH/T engine with custom values.
+ * This configuration is volatile, i.e. the parameters will be reverted
+ * to their default values after a device reset.
+ *
+ * For more details on how to compensate the temperature on the SEN6x platform,
+ * refer to “Temperature Acceleration and Compensation Instructions for SEN6x” [3].
+ */
+uint8_t SEN6x::SetTempAccelMode(sen6x_RHT_comp *table)
+{
+  uint8_t ret;
+
+  // CAN NOT be done when measuring
+  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+  ret = I2C_fill_buffer(SEN6x_SET_TEMP_ACCEL, table);
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_TEMP_ACC_PARAM);
+
+  //sensor will be restarted with next value request
+  return(ret);
+}
+
+/**
+ * Applies to: SEN63C, SEN65, SEN66, SEN68
+ * Using the sen5x information for now. (December 2024)
+ */
+uint8_t SEN6x::SetTmpComp(sen6x_tmp_comp *tmp)
+{
+  uint8_t ret;
+  sen6x_tmp_comp t;
+
+  t.offset = tmp->offset * 200;
+  t.slope = tmp->slope * 1000;
+  t.slot = tmp->slot;
+  t.time = tmp->time;
+
+  // check slot (not clear what this is. awaiting on documentation)???
+  if (t.slot > 4) t.slot  = 4;
+
+  ret = I2C_fill_buffer(SEN6x_SET_TEMP_COMP, &t);
+
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_TEMP_OFFSET);
+
+  return(ret);
+}
+
+/**
+ * Applies to: SEN63C, SEN65, SEN66, SEN68
+ *
+ *  @brief This command allows you to use the inbuilt heater
+ * in SHT sensor to reverse creep at high humidity.
+ *
+ * This command activates the SHT sensor heater with 200mW for 1s.
+ * The heater is then automatically deactivated again.
+ *
+ * Wait at least 20s after this command before starting a measurement
+ * to get coherent temperature values (heating consequence to disappear).
+ *
+ * No wait is implemented as this can/must be done in the sketch to enable
+ * checking other values.
+ */
+bool SEN6x::ActivateSHTHeater()
+{
+  // CAN NOT be done when measuring
+  if (! CheckToStop()) return(false);
+
+  // includes waiting for the heater to finish
+  bool ret = SendCommand(SEN6x_ACTIVATE_SHT_HEATER);
+
+  //will be restarted with next value request
+  return(ret);
+}
+
+///////////////////////// VOC related routines ////////////////
+//************************************************************/
+
+/**
+ * Applies to: SEN65, SEN66, SEN68
+ *
+ * @brief Allows backup of the VOC algorithm state to resume
+ * operation after a power cycle or device reset, skipping initial learning phase.
+ *
+ * By default, the VOC Engine is reset, and the algorithm state is retained if a
+ * measurement is stopped and started again. If the VOC algorithm state shall be
+ * reset, a device reset, or a power cycle can be executed.
+ *
+ * Gets the current VOC algorithm state. This data can be used to restore the
+ * state with Set VOC Algorithm State command after a short power cycle or device reset.
+ *
+ * This command can be used either in measure mode or in idle mode (which will
+ * then return the state at the time when the measurement was stopped).
+ * In measure mode, the state can be read each measure interval to always have
+ * the latest state available, even in case of a sudden power loss.
+ */
+uint8_t SEN6x::GetVocAlgorithmState(uint8_t *table, uint8_t tablesize)
+{
+  uint8_t ret;
+
+  if (! SetCommand(SEN6x_GET_SET_VOC_STATE)) return(SEN6x_ERR_UNKNOWNCMD);
+
+  // Check for Voc Algorithm length
+  if (tablesize < VOC_ALO_SIZE) return(SEN6x_ERR_PARAMETER);
+
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_VOC_STATE, VOC_ALO_SIZE);
+
+  // save VOC data
+  if (ret == SEN6x_ERR_OK) memcpy(table, _Receive_BUF, VOC_ALO_SIZE);
+  else memset(table, 0x0, VOC_ALO_SIZE);
+
+  return(ret);
 }
 
 /**
@@ -777,7 +1191,7 @@ uint8_t SEN6x::SetVocAlgorithmState(uint8_t *table, uint8_t tablesize)
 
   ret = I2C_fill_buffer(SEN6x_SET_VOC_STATE, table);
 
-  if (ret == SEN6x_ERR_OK)   ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK)   ret = I2C_SetPointer_Wait(SEN6x_GET_SET_VOC_STATE);
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -803,17 +1217,27 @@ uint8_t SEN6x::GetVocAlgorithm(sen6x_xox *voc)
   uint16_t cmnd  = LookupCommand(SEN6x_GET_SET_VOC_TUNING);
   if (cmnd == 0x0000 ) return(SEN6x_ERR_UNKNOWNCMD);
 
+  if (_Shadow.valid & SEN6x_SHADOW_VOC) {
+    memcpy(voc, &_Shadow.voc, sizeof(sen6x_xox));
+    return(SEN6x_ERR_OK);
+  }
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   I2C_fill_buffer(cmnd);
-  ret = I2C_SetPointer_Read(12);
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_VOC_TUNING, 12);
 
-  voc->IndexOffset  = byte_to_int16_t(0) ;
-  voc->LearnTimeOffsetHours  = byte_to_int16_t(2) ;
-  voc->LearnTimeGainHours  = byte_to_int16_t(4) ;
-  voc->GateMaxDurationMin  = byte_to_int16_t(6) ;
-  voc->stdInitial  = byte_to_int16_t(8) ;
-  voc->GainFactor  = byte_to_int16_t(10) ;
+  if (ret == SEN6x_ERR_OK) {
+    voc->IndexOffset  = byte_to_int16_t(0) ;
+    voc->LearnTimeOffsetHours  = byte_to_int16_t(2) ;
+    voc->LearnTimeGainHours  = byte_to_int16_t(4) ;
+    voc->GateMaxDurationMin  = byte_to_int16_t(6) ;
+    voc->stdInitial  = byte_to_int16_t(8) ;
+    voc->GainFactor  = byte_to_int16_t(10) ;
+
+    ShadowStore(SEN6x_SHADOW_VOC, &_Shadow.voc, voc, sizeof(sen6x_xox));
+  }
+  else memset(voc, 0x0, sizeof(sen6x_xox));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -836,19 +1260,24 @@ uint8_t SEN6x::SetVocAlgorithm(sen6x_xox *voc)
 {
   uint8_t ret;
 
-  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
-
   // check limits (else default according to datasheet)
   if (voc->IndexOffset > 250 || voc->IndexOffset < 1) voc->IndexOffset = 100;
   if (voc->LearnTimeOffsetHours > 1000 || voc->LearnTimeOffsetHours < 1) voc->LearnTimeOffsetHours = 12;
   if (voc->LearnTimeGainHours > 1000 || voc->LearnTimeGainHours < 1) voc->LearnTimeGainHours = 12;
   if (voc->GateMaxDurationMin > 3000 || voc->GateMaxDurationMin < 1) voc->GateMaxDurationMin = 180;
-  if (voc->GateMaxDurationMin > 5000 || voc->GateMaxDurationMin < 10) voc->GateMaxDurationMin = 50;
+  if (voc->stdInitial > 5000 || voc->stdInitial < 10) voc->stdInitial = 50;
   if (voc->GainFactor > 1000 || voc->GainFactor < 1) voc->GainFactor = 230;
 
+  // unchanged : nothing to send
+  if (ShadowSame(SEN6x_SHADOW_VOC, &_Shadow.voc, voc, sizeof(sen6x_xox))) return(SEN6x_ERR_OK);
+
+  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
   ret = I2C_fill_buffer(SEN6x_SET_VOC_TUNING, voc);
 
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_GET_SET_VOC_TUNING);
+
+  if (ret == SEN6x_ERR_OK) ShadowStore(SEN6x_SHADOW_VOC, &_Shadow.voc, voc, sizeof(sen6x_xox));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -873,18 +1302,28 @@ uint8_t SEN6x::GetNoxAlgorithm(sen6x_xox *nox)
   uint16_t cmnd  = LookupCommand(SEN6x_GET_SET_NOX_TUNING);
   if (cmnd == 0x0000 ) return(SEN6x_ERR_UNKNOWNCMD);
 
+  if (_Shadow.valid & SEN6x_SHADOW_NOX) {
+    memcpy(nox, &_Shadow.nox, sizeof(sen6x_xox));
+    return(SEN6x_ERR_OK);
+  }
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   I2C_fill_buffer(cmnd);
 
-  ret = I2C_SetPointer_Read(12);
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_NOX_TUNING, 12);
 
-  nox->IndexOffset  = byte_to_int16_t(0) ;
-  nox->LearnTimeOffsetHours  = byte_to_int16_t(2) ;
-  nox->LearnTimeGainHours  = byte_to_int16_t(4) ;
-  nox->GateMaxDurationMin  = byte_to_int16_t(6) ;
-  nox->stdInitial  = byte_to_int16_t(8) ;
-  nox->GainFactor  = byte_to_int16_t(10) ;
+  if (ret == SEN6x_ERR_OK) {
+    nox->IndexOffset  = byte_to_int16_t(0) ;
+    nox->LearnTimeOffsetHours  = byte_to_int16_t(2) ;
+    nox->LearnTimeGainHours  = byte_to_int16_t(4) ;
+    nox->GateMaxDurationMin  = byte_to_int16_t(6) ;
+    nox->stdInitial  = byte_to_int16_t(8) ;
+    nox->GainFactor  = byte_to_int16_t(10) ;
+
+    ShadowStore(SEN6x_SHADOW_NOX, &_Shadow.nox, nox, sizeof(sen6x_xox));
+  }
+  else memset(nox, 0x0, sizeof(sen6x_xox));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -902,8 +1341,6 @@ uint8_t SEN6x::SetNoxAlgorithm(sen6x_xox *nox)
 {
   uint8_t ret;
 
-  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
-
   // MUST be / strongly advised values (according to datasheet))
   nox->LearnTimeGainHours = 12;
   nox->stdInitial = 50;
@@ -914,9 +1351,16 @@ uint8_t SEN6x::SetNoxAlgorithm(sen6x_xox *nox)
   if (nox->GateMaxDurationMin > 3000 || nox->GateMaxDurationMin < 1) nox->GateMaxDurationMin = 720;
   if (nox->GainFactor > 1000 || nox->GainFactor < 1) nox->GainFactor = 230;
 
+  // unchanged : nothing to send
+  if (ShadowSame(SEN6x_SHADOW_NOX, &_Shadow.nox, nox, sizeof(sen6x_xox))) return(SEN6x_ERR_OK);
+
+  if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
   ret = I2C_fill_buffer(SEN6x_SET_NOX_TUNING, nox);
 
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_GET_SET_NOX_TUNING);
+
+  if (ret == SEN6x_ERR_OK) ShadowStore(SEN6x_SHADOW_NOX, &_Shadow.nox, nox, sizeof(sen6x_xox));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -945,26 +1389,14 @@ uint8_t SEN6x::ForceCO2Recal(uint16_t *val)
 
   _data16 = *val;
 
-  // max wait time indicated after stop
-  delay(1000);
-
+  // The 600mS needed after stopping a measurement is covered
+  // by the execution time of the stop command.
   ret = I2C_fill_buffer(SEN6x_SET_FORCE_C02_CAL);
-  Serial.println(ret);
 
   if (ret == SEN6x_ERR_OK) {
 
-    // send command
-    ret  = I2C_SetPointer();
-
-    if (ret == SEN6x_ERR_OK) return (ret);
-
-    // wait recalibration time x 2
-    delay(1000);
-
-    if (! SetCommand(SEN6x_FORCE_C02_CAL) ) return(SEN6x_ERR_UNKNOWNCMD);
-
-    // read result
-    ret = I2C_ReadToBuffer(2, false);
+    // send command, wait recalibration time (500mS) and read result
+    ret = I2C_SetPointer_Read(SEN6x_FORCE_C02_CAL, 2);
 
     if (ret == SEN6x_ERR_OK)  *val = byte_to_Uint16_t(0) ;
   }
@@ -993,12 +1425,20 @@ uint8_t SEN6x::GetCo2SelfCalibratrion(bool *val)
   uint16_t cmnd  = LookupCommand(SEN6x_GET_SET_C02_CAL);
   if (cmnd == 0x0000 ) return(SEN6x_ERR_UNKNOWNCMD);
 
+  if (_Shadow.valid & SEN6x_SHADOW_ASC) {
+    *val = _Shadow.asc;
+    return(SEN6x_ERR_OK);
+  }
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   I2C_fill_buffer(cmnd);
-  ret = I2C_SetPointer_Read(2);
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_C02_CAL, 2);
 
-  if( ret == SEN6x_ERR_OK) *val = (bool) _Receive_BUF[1];
+  if( ret == SEN6x_ERR_OK) {
+    *val = (bool) _Receive_BUF[1];
+    ShadowStore(SEN6x_SHADOW_ASC, &_Shadow.asc, val, sizeof(bool));
+  }
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -1020,13 +1460,18 @@ uint8_t SEN6x::SetCo2SelfCalibratrion(bool val)
 {
   uint8_t ret;
 
+  // unchanged : nothing to send
+  if (ShadowSame(SEN6x_SHADOW_ASC, &_Shadow.asc, &val, sizeof(bool))) return(SEN6x_ERR_OK);
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   _data16 = (uint16_t) val;
 
   ret = I2C_fill_buffer(SEN6X_SET_SELF_CO2_CAL);
 
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_GET_SET_C02_CAL);
+
+  if (ret == SEN6x_ERR_OK) ShadowStore(SEN6x_SHADOW_ASC, &_Shadow.asc, &val, sizeof(bool));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -1052,9 +1497,17 @@ uint8_t SEN6x::GetAmbientPressure(uint16_t *val)
 
   if (! SetCommand(SEN6x_GET_SET_AMBIENT_PRESS)) return(SEN6x_ERR_UNKNOWNCMD);
 
-  ret = I2C_SetPointer_Read(2);
+  if (_Shadow.valid & SEN6x_SHADOW_PRESSURE) {
+    *val = _Shadow.pressure;
+    return(SEN6x_ERR_OK);
+  }
 
-  if (ret == SEN6x_ERR_OK) *val = byte_to_Uint16_t(0);
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_AMBIENT_PRESS, 2);
+
+  if (ret == SEN6x_ERR_OK) {
+    *val = byte_to_Uint16_t(0);
+    ShadowStore(SEN6x_SHADOW_PRESSURE, &_Shadow.pressure, val, sizeof(uint16_t));
+  }
 
   return(ret);
 }
@@ -1082,11 +1535,16 @@ uint8_t SEN6x::SetAmbientPressure(uint16_t val)
 
   if (val < 700 || val > 1200) return(SEN6x_ERR_PARAMETER);
 
+  // unchanged : nothing to send
+  if (ShadowSame(SEN6x_SHADOW_PRESSURE, &_Shadow.pressure, &val, sizeof(uint16_t))) return(SEN6x_ERR_OK);
+
   _data16 = val;
 
   ret = I2C_fill_buffer(SEN6X_SET_AMBIENT_PRESSURE);
 
-  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK) ret = I2C_SetPointer_Wait(SEN6x_GET_SET_AMBIENT_PRESS);
+
+  if (ret == SEN6x_ERR_OK) ShadowStore(SEN6x_SHADOW_PRESSURE, &_Shadow.pressure, &val, sizeof(uint16_t));
 
   return(ret);
 }
@@ -1114,12 +1572,20 @@ uint8_t SEN6x::GetAltitude(uint16_t *val)
   uint16_t cmnd  = LookupCommand(SEN6x_GET_SET_ALTITUDE);
   if (cmnd == 0x0000 ) return(SEN6x_ERR_UNKNOWNCMD);
 
+  if (_Shadow.valid & SEN6x_SHADOW_ALTITUDE) {
+    *val = _Shadow.altitude;
+    return(SEN6x_ERR_OK);
+  }
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   I2C_fill_buffer(cmnd);
-  ret = I2C_SetPointer_Read(2);
+  ret = I2C_SetPointer_Read(SEN6x_GET_SET_ALTITUDE, 2);
 
-  if( ret == SEN6x_ERR_OK)  *val = byte_to_Uint16_t(0);
+  if( ret == SEN6x_ERR_OK) {
+    *val = byte_to_Uint16_t(0);
+    ShadowStore(SEN6x_SHADOW_ALTITUDE, &_Shadow.altitude, val, sizeof(uint16_t));
+  }
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -1147,13 +1613,18 @@ uint8_t SEN6x::SetAltitude(uint16_t val)
 
   if (val > 3000) return(SEN6x_ERR_PARAMETER);
 
+  // unchanged : nothing to send
+  if (ShadowSame(SEN6x_SHADOW_ALTITUDE, &_Shadow.altitude, &val, sizeof(uint16_t))) return(SEN6x_ERR_OK);
+
   if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
 
   _data16 = val;
 
   ret = I2C_fill_buffer(SEN6X_SET_ALTITUDE);
 
-  if (ret == SEN6x_ERR_OK)  ret = I2C_SetPointer();
+  if (ret == SEN6x_ERR_OK)  ret = I2C_SetPointer_Wait(SEN6x_GET_SET_ALTITUDE);
+
+  if (ret == SEN6x_ERR_OK) ShadowStore(SEN6x_SHADOW_ALTITUDE, &_Shadow.altitude, &val, sizeof(uint16_t));
 
   if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
 
@@ -1172,19 +1643,126 @@ uint8_t SEN6x::SetAltitude(uint16_t val)
  */
 void SEN6x::GetErrDescription(uint8_t code, char *buf, int len)
 {
-
-#if defined SMALLFOOTPRINT
-  strncpy(buf, "SmallFootprint: Info not enabled", len);
-#else
   int i=0;
 
-  while (SEN6x_ERR_desc[i].code != 0xff) {
-      if(SEN6x_ERR_desc[i].code == code) break;
+  while (SEN6x_READ_BYTE(&SEN6x_ERR_desc[i].code) != 0xff) {
+      if(SEN6x_READ_BYTE(&SEN6x_ERR_desc[i].code) == code) break;
       i++;
   }
 
-  strncpy(buf, SEN6x_ERR_desc[i].desc, len);
-#endif // SMALLFOOTPRINT
+  SEN6x_STRNCPY(buf, SEN6x_ERR_desc[i].desc, len);
+}
+
+/**
+ * @brief : set the I2C clock
+ *
+ * @param clock : SEN6x_CLOCK_MIN to SEN6x_CLOCK_FAST
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PARAMETER : clock out of range
+ *  SEN6x_ERR_UNKNOWNCMD : transport can not set clock
+ */
+uint8_t SEN6x::SetClock(uint32_t clock)
+{
+  uint8_t ret;
+
+  if (clock < SEN6x_CLOCK_MIN || clock > SEN6x_CLOCK_FAST) return(SEN6x_ERR_PARAMETER);
+
+  // will be set in begin()
+  if (_transport == NULL) {
+    _Clock = clock;
+    return(SEN6x_ERR_OK);
+  }
+
+  ret = _transport->setClock(clock);
+
+  if (ret == SEN6x_ERR_OK) {
+    _Clock = clock;
+    _ClkErrors = _ClkReads = 0;
+  }
+
+  return(ret);
+}
+
+uint32_t SEN6x::GetClock()
+{
+  return(_Clock);
+}
+
+void SEN6x::SetClockFallback(uint8_t errors, uint8_t window)
+{
+  _ClkMaxErrors = errors;
+  _ClkWindow = window ? window : 1;
+  _ClkErrors = _ClkReads = 0;
+}
+
+void SEN6x::SetRetry(uint8_t retries, uint16_t backoff)
+{
+  _Retries = retries;
+  _Backoff = backoff;
+}
+
+/**
+ * @brief : recover the I2C bus and set the clock again
+ */
+uint8_t SEN6x::RecoverBus()
+{
+  uint8_t ret;
+
+  // if NO begin was done
+  if (_transport == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  ret = _transport->recover();
+
+  if (ret == SEN6x_ERR_UNKNOWNCMD) return(ret);
+
+  if (ret != SEN6x_ERR_OK) DBPRINT("ERROR: I2C bus is still held low\r\n");
+
+  _transport->setClock(_Clock);
+  SEN6x_STAT(_Stats.recovers++);
+
+  return(ret);
+}
+
+#if not defined SEN6x_HOST
+void SEN6x::SetBusPins(uint8_t scl, uint8_t sda)
+{
+  _TwoWire.SetPins(scl, sda);
+}
+#endif
+
+/**
+ * @brief : keep track of CRC and short-read errors and fall back
+ * to standard mode clock when too many errors within the window
+ *
+ * @param error :
+ *  false : count a read
+ *  true  : count an error on the last read
+ */
+void SEN6x::ClockCheck(bool error)
+{
+  if (! error) {
+
+    // start new window
+    if (_ClkReads++ >= _ClkWindow) {
+      _ClkReads = 1;
+      _ClkErrors = 0;
+    }
+
+    return;
+  }
+
+  if (_ClkMaxErrors == 0 || ++_ClkErrors < _ClkMaxErrors) return;
+
+  _ClkErrors = _ClkReads = 0;
+
+  if (_Clock <= SEN6x_CLOCK_STANDARD) return;
+
+  DBPRINT("Too many I2C errors, clock falls back to standard mode\r\n");
+
+  if (_transport->setClock(SEN6x_CLOCK_STANDARD) == SEN6x_ERR_OK)
+    _Clock = SEN6x_CLOCK_STANDARD;
 }
 
 /**
@@ -1207,10 +1785,47 @@ bool SEN6x::CheckToStop()
       return(false);
     }
 
-    _restart = true;
-  }
+    SEN6x_STAT(_Stats.stops++);
+    _restart = true;
+  }
+
+  return(true);
+}
+
+/**
+ * @brief forget the cached volatile configuration
+ */
+void SEN6x::ClearCache()
+{
+  _Shadow.valid = 0;
+}
+
+/**
+ * @brief store a value in the cache of volatile configuration
+ *
+ * @param bit    : SEN6x_SHADOW_xxx
+ * @param shadow : field in _Shadow
+ * @param val    : value as written or read
+ * @param len    : length of value
+ */
+void SEN6x::ShadowStore(uint8_t bit, void *shadow, const void *val, uint8_t len)
+{
+  memcpy(shadow, val, len);
+  _Shadow.valid |= bit;
+}
+
+/**
+ * @brief check a value is the same as in the cache
+ *
+ * @return
+ *  true  : cached and same value
+ *  false : not cached or different value
+ */
+bool SEN6x::ShadowSame(uint8_t bit, const void *shadow, const void *val, uint8_t len)
+{
+  if (! (_Shadow.valid & bit)) return(false);
 
-  return(true);
+  return(memcmp(shadow, val, len) == 0);
 }
 
 /**
@@ -1222,15 +1837,27 @@ bool SEN6x::CheckToStop()
  */
 bool SEN6x::CheckWasStarted()
 {
+  // no measurement between beginConfig() and commit()
+  if (_restart && _config) {
+    DBPRINT("ERROR: Can not start measurement during configuration\r\n");
+    _restart = false;
+    return(false);
+  }
+
   if (_restart) {
+    unsigned long t = millis();
 
     if (! start()) {
       DBPRINT("ERROR: Could not (re)start measurement\r\n");
       return(false);
     }
 
-    // give some time to start
-    delay(1000);
+    // the first measurement is ready about 1 second after start. The
+    // execution time of start() is part of that second.
+    while (millis() - t < SEN6x_START_WAIT) yield();
+
+    SEN6x_STAT(_Stats.restarts++);
+    SEN6x_STAT(_Stats.delayTime += millis() - t);
 
     _restart = false;
   }
@@ -1306,7 +1933,7 @@ bool SEN6x::SetCommand(Sen6x_Comds_offset req){
  * else valid opcode
  */
 uint16_t SEN6x::LookupCommand(Sen6x_Comds_offset cmd){
-  return(SEN6xCommandOpCode[_device][cmd]);
+  return(SEN6x_OPCODE(_device, cmd));
 }
 
 /**
@@ -1319,12 +1946,118 @@ uint16_t SEN6x::LookupCommand(Sen6x_Comds_offset cmd){
 bool SEN6x::SendCommand(Sen6x_Comds_offset req)
 {
   if ( SetCommand(req) ) {
-    if (I2C_SetPointer() == SEN6x_ERR_OK) return(true);
+    if (I2C_SetPointer_Wait(req) == SEN6x_ERR_OK) return(true);
   }
 
   return(false);
 }
 
+/**
+ * @brief Get the number of data bytes (excluding CRC) returned
+ * by a command for the sensor type
+ *
+ * @return
+ * 0 : command does not return data
+ * else number of bytes
+ */
+uint8_t SEN6x::ReadLength(Sen6x_Comds_offset req)
+{
+  switch(req) {
+
+    case SEN6x_READ_DATA_RDY_FLAG:
+    case SEN6x_FORCE_C02_CAL:
+    case SEN6x_GET_SET_C02_CAL:
+    case SEN6x_GET_SET_AMBIENT_PRESS:
+    case SEN6x_GET_SET_ALTITUDE:
+      return(2);
+
+    case SEN6x_READ_MEASURED_VALUE:
+      if (_device == SEN63C) return(14);
+      if (_device == SEN65)  return(16);
+      return(18);             // SEN60, SEN66, SEN68
+
+    case SEN6x_READ_RAW_VALUE:
+      if (_device == SEN63C) return(4);
+      if (_device == SEN66)  return(10);
+      return(8);              // SEN65, SEN68
+
+    case SEN6x_NUM_CONC_VALUES:
+      return(10);
+
+    case SEN6x_READ_PRODUCT_NAME:
+    case SEN6x_READ_SERIAL_NUMBER:
+      return(32);
+
+    case SEN6x_READ_VERSION:
+    case SEN6x_GET_SET_VOC_STATE:
+      return(8);
+
+    case SEN6x_READ_DEVICE_REGISTER:
+    case SEN6x_RD_CL_DEVICE_REGISTER:
+      if (_device == SEN60) return(2);
+      return(4);
+
+    case SEN6x_GET_SET_VOC_TUNING:
+    case SEN6x_GET_SET_NOX_TUNING:
+      return(12);
+
+    default:
+      return(0);
+  }
+}
+
+/**
+ * @brief Get the time the command needs to execute on the device
+ *
+ * @return
+ * time in mS (as in the datasheet)
+ */
+uint16_t SEN6x::CommandWait(Sen6x_Comds_offset req)
+{
+  return(SEN6x_EXECTIME(_device, req));
+}
+
+/**
+ * @brief Check the command can be send again after a bus error.
+ *
+ * Not if executing it twice has a different result, or the device
+ * NACKs it when the first one was executed after all.
+ *
+ * @return
+ * true : can be retried
+ */
+bool SEN6x::CommandRetry(Sen6x_Comds_offset req)
+{
+  switch(req) {
+    case SEN6x_START_MEASUREMENT:     // NACK when measuring
+    case SEN6x_STOP_MEASUREMENT:      // NACK when idle
+    case SEN6x_RD_CL_DEVICE_REGISTER: // status is cleared by the first
+    case SEN6x_RESET:
+    case SEN6x_START_FAN_CLEANING:
+    case SEN6x_ACTIVATE_SHT_HEATER:
+    case SEN6x_FORCE_C02_CAL:
+      return(false);
+
+    default:
+      return(true);
+  }
+}
+
+/**
+ * @brief Check the last transaction was completed for the
+ * command and return the result.
+ *
+ * @return
+ * SEN6x_ERR_CMDSTATE : no completed transaction for this command
+ * else result of the transaction
+ */
+uint8_t SEN6x::TransCheck(Sen6x_Comds_offset req)
+{
+  if (_TransState != SEN6x_TRANS_DONE || _TransReq != req) return(SEN6x_ERR_CMDSTATE);
+
+  return(_TransResult);
+}
+
 ////////////////// convert routines ///////////////////////////
 //************************************************************/
 /**
@@ -1383,11 +2116,13 @@ int16_t SEN6x::byte_to_int16_t(int x)
 /**
  * @brief : start I2C communication from library
  */
+#if not defined SEN6x_HOST
 void SEN6x::I2C_init()
 {
   _i2cPort->begin();
-  _i2cPort->setClock(100000);
+  _i2cPort->setClock(_Clock);
 }
+#endif
 
 /**
  * @brief : Fill buffer to send over I2C communication
@@ -1504,7 +2239,7 @@ uint8_t SEN6x::I2C_fill_buffer(uint16_t cmnd, void *val)
       _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[8]); //10 CRC
       _Send_BUF[i++] = t->slot >>8 & 0xff;            //11 MSB
       _Send_BUF[i++] = t->slot & 0xff;                //12 LSB
-      _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[8]); //13 CRC
+      _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[11]); //13 CRC
       break;
 
     case SEN6x_SET_TEMP_ACCEL:
@@ -1525,7 +2260,7 @@ uint8_t SEN6x::I2C_fill_buffer(uint16_t cmnd, void *val)
       _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[8]); //10 CRC
       _Send_BUF[i++] = ta->T2 >>8 & 0xff;            //11 MSB
       _Send_BUF[i++] = ta->T2 & 0xff;                //12 LSB
-      _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[8]); //13 CRC
+      _Send_BUF[i++] = I2C_calc_CRC(&_Send_BUF[11]); //13 CRC
       break;
 
      case SEN6x_SET_FORCE_C02_CAL:
@@ -1598,9 +2333,12 @@ uint8_t SEN6x::I2C_fill_buffer(uint16_t cmnd, void *val)
 uint8_t SEN6x::I2C_SetPointer()
 {
   // if NO begin was done
-  if (_i2cPort == NULL) return(SEN6x_ERR_CMDSTATE);
+  if (_transport == NULL) return(SEN6x_ERR_CMDSTATE);
 
-  if (_Send_BUF_Length == 0) return(SEN6x_ERR_DATALENGTH);
+  if (_Send_BUF_Length == 0) {
+    SEN6x_STAT(_Stats.lengthErrors++);
+    return(SEN6x_ERR_DATALENGTH);
+  }
 
   if(_device == SEN60) _I2CAddress = SEN60_I2CAddress;
   else _I2CAddress = SEN6x_I2CAddress;
@@ -1613,16 +2351,22 @@ uint8_t SEN6x::I2C_SetPointer()
     DBPRINT("\r\n");
   }
 
-  _i2cPort->beginTransmission(_I2CAddress);
-  _i2cPort->write(_Send_BUF, _Send_BUF_Length);
-  _i2cPort->endTransmission();
+#if defined SEN6x_STATISTICS
+  uint8_t ret = _transport->write(_I2CAddress, _Send_BUF, _Send_BUF_Length);
 
-  return(SEN6x_ERR_OK);
+  if (ret == SEN6x_ERR_OK) _Stats.bytesSent += _Send_BUF_Length;
+  else _Stats.writeErrors++;
+
+  return(ret);
+#else
+  return(_transport->write(_I2CAddress, _Send_BUF, _Send_BUF_Length));
+#endif
 }
 
 /**
  * @brief : read with I2C communication
  *
+ * @param req: command in _Send_BUF (used for execution time)
  * @param cnt: number of data bytes to get
  *
  * @param chk_zero : needed for read info buffer
@@ -1633,36 +2377,280 @@ uint8_t SEN6x::I2C_SetPointer()
  * OK   SEN6x_ERR_OK
  * else error
  */
-uint8_t SEN6x::I2C_SetPointer_Read(uint8_t cnt, bool chk_zero)
+uint8_t SEN6x::I2C_SetPointer_Read(Sen6x_Comds_offset req, uint8_t cnt, bool chk_zero)
+{
+  uint8_t ret;
+
+  ret = I2C_Submit(req, cnt, chk_zero);
+
+  if (ret == SEN6x_ERR_OK) ret = I2C_Wait();
+
+  return(ret);
+}
+
+/**
+ * @brief : write _Send_BUF and wait for the command to execute
+ *
+ * @param req: command in _Send_BUF (used for execution time)
+ *
+ * @return :
+ * OK   SEN6x_ERR_OK
+ * else error
+ */
+uint8_t SEN6x::I2C_SetPointer_Wait(Sen6x_Comds_offset req)
+{
+  return(I2C_SetPointer_Read(req, 0));
+}
+
+////////////////// transaction engine /////////////////////////
+//************************************************************/
+
+/**
+ * @brief : submit a command without waiting for the result
+ *
+ * @param req: command to execute
+ *
+ * @return :
+ * OK   SEN6x_ERR_OK
+ * else error
+ */
+uint8_t SEN6x::submit(Sen6x_Comds_offset req)
+{
+  bool chk_zero;
+
+  // these need parameters
+  if (req == SEN6x_TEMP_OFFSET || req == SEN6x_TEMP_ACC_PARAM || req == SEN6x_FORCE_C02_CAL)
+    return(SEN6x_ERR_PARAMETER);
+
+  if (_TransState == SEN6x_TRANS_BUSY) return(SEN6x_ERR_CMDSTATE);
+
+  if (! SetCommand(req)) return(SEN6x_ERR_UNKNOWNCMD);
+
+  // Serial and product name are zero terminated
+  chk_zero = (req == SEN6x_READ_PRODUCT_NAME || req == SEN6x_READ_SERIAL_NUMBER);
+
+  return(I2C_Submit(req, ReadLength(req), chk_zero));
+}
+
+/**
+ * @brief : move pending transaction forward
+ *
+ * @return :
+ * true  : transaction is complete (or none pending)
+ * false : transaction still pending
+ */
+bool SEN6x::poll()
+{
+  return(I2C_Poll());
+}
+
+/**
+ * @brief : obtain the result of the last transaction
+ *
+ * @return :
+ * SEN6x_ERR_CMDSTATE : transaction still pending
+ * else result of the transaction
+ */
+uint8_t SEN6x::result()
+{
+  if (_TransState == SEN6x_TRANS_BUSY) return(SEN6x_ERR_CMDSTATE);
+
+  return(_TransResult);
+}
+
+/**
+ * @brief : send the command in _Send_BUF and start a transaction
+ *
+ * @param req: command in _Send_BUF
+ * @param cnt: number of data bytes to read after execution (0 = none)
+ * @param chk_zero: check for zero termination (Serial and product code)
+ *
+ * @return :
+ * OK   SEN6x_ERR_OK
+ * else error
+ */
+uint8_t SEN6x::I2C_Submit(Sen6x_Comds_offset req, uint8_t cnt, bool chk_zero)
 {
   uint8_t ret;
 
+  if (_TransState == SEN6x_TRANS_BUSY) return(SEN6x_ERR_CMDSTATE);
+
+  _TransState = SEN6x_TRANS_IDLE;
+  _TransReq = req;
+  _TransTry = 0;
+
   // set pointer
   ret = I2C_SetPointer();
 
-  if (ret != SEN6x_ERR_OK) {
+  _TransStart = _TransSubmit = millis();
+  _TimeSent = _TimeSrc();
+
+  if (ret == SEN6x_ERR_OK) {
+    _TransWait = CommandWait(req);
+    _TransResend = false;
+  }
+  else {
     DBPRINT("Can not set pointer\r\n");
-    return(ret);
+    ClearCache();               // sensor might have lost power
+
+    if (! I2C_Retry(ret, true)) {
+      SEN6x_STAT(StatCommand(req, 0, true));
+      return(ret);
+    }
   }
 
-  // Taking enough time for the command to execute on device.
-  delay(100);
+  _TransCnt = cnt;
+  _TransChkZero = chk_zero;
 
-  // read from Sensor
-  ret = I2C_ReadToBuffer(cnt, chk_zero);
+  // measured values are decoded straight from the received frame
+  _TransRaw = (req == SEN6x_READ_MEASURED_VALUE || req == SEN6x_READ_RAW_VALUE || req == SEN6x_NUM_CONC_VALUES);
+  _TransResult = SEN6x_ERR_CMDSTATE;
+  _TransState = SEN6x_TRANS_BUSY;
 
-  if (_Debug) {
-    DBPRINT("I2C Received: ");
-    for(byte i = 0; i < _Receive_BUF_Length; i++)
-      DBPRINT1("0x%02X ",_Receive_BUF[i]);
-    DBPRINT1("length: %d\r\n",_Receive_BUF_Length);
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : complete the pending transaction once the
+ * execution time of the command has passed.
+ *
+ * After a failure the command can be send again (see SetRetry())
+ *
+ * @return :
+ * true  : transaction is complete (or none pending)
+ * false : transaction still pending
+ */
+bool SEN6x::I2C_Poll()
+{
+  uint8_t ret;
+
+  if (_TransState != SEN6x_TRANS_BUSY) return(true);
+
+  // Taking enough time for the command to execute on device (or backoff).
+  if (millis() - _TransStart < _TransWait) return(false);
+
+  // backoff has passed, send the command again
+  if (_TransResend) {
+    ret = I2C_SetPointer();
+
+    if (ret == SEN6x_ERR_OK) {
+      _TransResend = false;
+      _TransWait = CommandWait(_TransReq);
+      _TransStart = millis();
+      return(false);
+    }
+
+    DBPRINT("Can not set pointer\r\n");
+    if (I2C_Retry(ret, true)) return(false);
+
+    return(I2C_Complete(ret));
   }
 
-  if (ret != SEN6x_ERR_OK) {
-    DBPRINT1("Error during reading from I2C (error): 0x%02X\r\n", ret);
+  ret = SEN6x_ERR_OK;
+
+  if (_TransCnt > 0) {
+
+    // read from Sensor
+    if (_TransRaw) ret = I2C_ReadFrame(_TransCnt);
+    else ret = I2C_ReadToBuffer(_TransCnt, _TransChkZero);
+
+    if (_Debug) {
+      DBPRINT("I2C Received: ");
+      for(byte i = 0; i < _Receive_BUF_Length; i++)
+        DBPRINT1("0x%02X ",_Receive_BUF[i]);
+      DBPRINT1("length: %d\r\n",_Receive_BUF_Length);
+    }
+
+    if (ret != SEN6x_ERR_OK) {
+      DBPRINT1("Error during reading from I2C (error): 0x%02X\r\n", ret);
+      if (I2C_Retry(ret, false)) return(false);
+    }
   }
 
-  return(ret);
+  return(I2C_Complete(ret));
+}
+
+/**
+ * @brief : schedule to send the command of the pending transaction
+ * again after the backoff
+ *
+ * @param ret     : result of the failed attempt
+ * @param recover : the command could not be written, recover the bus
+ *
+ * @return :
+ * true  : retry is scheduled
+ * false : no retry (not a bus error, not allowed or no retries left)
+ */
+bool SEN6x::I2C_Retry(uint8_t ret, bool recover)
+{
+  uint32_t wait;
+
+  if (ret != SEN6x_ERR_PROTOCOL || _TransTry >= _Retries) return(false);
+
+  if (! CommandRetry(_TransReq)) return(false);
+
+  // a device might hold SDA low
+  if (recover) RecoverBus();
+
+  wait = (uint32_t) _Backoff << (_TransTry < 8 ? _TransTry : 8);
+  _TransWait = wait > 0xFFFF ? 0xFFFF : wait;
+  _TransStart = millis();
+  _TransResend = true;
+  _TransTry++;
+
+  SEN6x_STAT(_Stats.retries++);
+  DBPRINT2("Retry %d after %d mS\r\n", _TransTry, _TransWait);
+
+  return(true);
+}
+
+/**
+ * @brief : complete the pending transaction with a result
+ *
+ * @return :
+ * true  : transaction is complete
+ */
+bool SEN6x::I2C_Complete(uint8_t ret)
+{
+  _TransResult = ret;
+
+  if (_TransResult != SEN6x_ERR_OK) ClearCache();
+
+  // keep track of measurement state
+  if (_TransResult == SEN6x_ERR_OK) {
+    if (_TransReq == SEN6x_START_MEASUREMENT) _started = true;
+    else if (_TransReq == SEN6x_STOP_MEASUREMENT) _started = false;
+    else if (_TransReq == SEN6x_RESET) {
+      _started = false;
+      ClearCache();             // volatile configuration is back to default
+    }
+
+    Meta();
+  }
+
+  SEN6x_STAT(StatCommand(_TransReq, millis() - _TransSubmit, _TransResult != SEN6x_ERR_OK));
+
+  _TransState = SEN6x_TRANS_DONE;
+
+  return(true);
+}
+
+/**
+ * @brief : wait for the pending transaction to complete
+ *
+ * @return :
+ * OK   SEN6x_ERR_OK
+ * else error
+ */
+uint8_t SEN6x::I2C_Wait()
+{
+  SEN6x_STAT(unsigned long start = millis());
+
+  while (! I2C_Poll()) yield();
+
+  SEN6x_STAT(_Stats.waitTime += millis() - start);
+
+  return(_TransResult);
 }
 
 /**
@@ -1678,10 +2666,9 @@ uint8_t SEN6x::I2C_SetPointer_Read(uint8_t cnt, bool chk_zero)
  */
 uint8_t SEN6x::I2C_ReadToBuffer(uint8_t count, bool chk_zero)
 {
-  uint8_t data[3];
-  uint8_t i, j, exp_cnt, rec_cnt;
+  uint8_t i, groups, exp_cnt, rec_cnt;
 
-  j = i = _Receive_BUF_Length = 0;
+  _Receive_BUF_Length = 0;
 
   // 2 data bytes  + crc
   exp_cnt = count / 2 * 3;
@@ -1692,49 +2679,52 @@ uint8_t SEN6x::I2C_ReadToBuffer(uint8_t count, bool chk_zero)
   if (exp_cnt > 32) exp_cnt = 32;
 #endif
 
-  rec_cnt = _i2cPort->requestFrom(_I2CAddress, exp_cnt);
+  // the frame is read in _Receive_BUF and compacted in place
+  if (exp_cnt > SEN6x_MAXBUFLENGTH) exp_cnt = SEN6x_MAXBUFLENGTH / 3 * 3;
+
+  // read the complete frame
+  _transport->read(_I2CAddress, _Receive_BUF, exp_cnt, &rec_cnt);
+
+  // count the read for the clock fallback
+  ClockCheck(false);
+
+  SEN6x_STAT(_Stats.bytesReceived += rec_cnt);
 
   if (rec_cnt != exp_cnt ){
     DBPRINT2("Did not receive all bytes: Expected 0x%02X, got 0x%02X\r\n",exp_cnt & 0xff,rec_cnt & 0xff);
+    SEN6x_STAT(_Stats.shortReads++);
+    ClockCheck(true);
     return(SEN6x_ERR_PROTOCOL);
   }
 
-  while (_i2cPort->available()) {  // read all
-
-    data[i++] = _i2cPort->read();
-//DBPRINT1("data 0x%02X\r\n");", data[i-1]);
-    // 2 bytes RH, 1 CRC
-    if( i == 3) {
-
-      if (data[2] != I2C_calc_CRC(&data[0])){
-        DBPRINT2("I2C CRC error: Expected 0x%02X, calculated 0x%02X\r\n",data[2] & 0xff,I2C_calc_CRC(&data[0]) & 0xff);
-        return(SEN6x_ERR_PROTOCOL);
-      }
-
-      _Receive_BUF[_Receive_BUF_Length++] = data[0];
-      _Receive_BUF[_Receive_BUF_Length++] = data[1];
+  // check the CRC of the complete frame
+  groups = SEN6x_CheckFrame(_Receive_BUF, rec_cnt);
 
-      i = 0;
-
-      // check for zero termination (Serial and product code)
-      if (chk_zero) {
+  if (groups != rec_cnt / 3) {
+    i = groups * 3;
+    DBPRINT2("I2C CRC error: Expected 0x%02X, calculated 0x%02X\r\n",_Receive_BUF[i + 2] & 0xff, SEN6x_CRC(&_Receive_BUF[i]));
+    SEN6x_STAT(_Stats.crcErrors++);
+    ClockCheck(true);
+    return(SEN6x_ERR_PROTOCOL);
+  }
 
-        if (data[0] == 0 && data[1] == 0) {
+  // 2 bytes data, 1 CRC. Remove the CRC from the buffer
+  for (i = 0; i + 3 <= rec_cnt && _Receive_BUF_Length < count; i += 3) {
 
-          // flush any bytes pending (if NOT clearing rxBuffer)
-          // Logged as an issue and expect this could be removed in the future
-          while (_i2cPort->available()) _i2cPort->read();
-          return(SEN6x_ERR_OK);
-        }
-      }
+    _Receive_BUF[_Receive_BUF_Length++] = _Receive_BUF[i];
+    _Receive_BUF[_Receive_BUF_Length++] = _Receive_BUF[i + 1];
 
-      if (_Receive_BUF_Length >= count) break;
+    // check for zero termination (Serial and product code)
+    if (chk_zero) {
+      if (_Receive_BUF[_Receive_BUF_Length - 2] == 0 && _Receive_BUF[_Receive_BUF_Length - 1] == 0)
+        return(SEN6x_ERR_OK);
     }
   }
 
-  if (i != 0) {
-    DBPRINT1("Error: Data counter %d\r\n",i);
-    while (j < i) _Receive_BUF[_Receive_BUF_Length++] = data[j++];
+  // incomplete group at the end (SEN6x_MAX_32_TO_EXPECT)
+  if (i < rec_cnt && _Receive_BUF_Length < count) {
+    DBPRINT1("Error: Data counter %d\r\n",rec_cnt - i);
+    while (i < rec_cnt) _Receive_BUF[_Receive_BUF_Length++] = _Receive_BUF[i++];
   }
 
   if (_Receive_BUF_Length == 0) {
@@ -1745,31 +2735,68 @@ uint8_t SEN6x::I2C_ReadToBuffer(uint8_t count, bool chk_zero)
   if (_Receive_BUF_Length == count) return(SEN6x_ERR_OK);
 
   DBPRINT2("Error: Expected bytes : %d, Received bytes %d\r\n", count,_Receive_BUF_Length);
+  SEN6x_STAT(_Stats.lengthErrors++);
 
   return(SEN6x_ERR_DATALENGTH);
 }
 
+/**
+ * @brief : receive frame from Sensor with I2C communication
+ * and check the CRC's. The frame is kept as received.
+ *
+ * @param count : number of data bytes to expect
+ *
+ * Used for the measured values. These are decoded with the frame layout
+ * (Sen6xLayouts.h) straight from the frame.
+ *
+ * @return :
+ * OK   SEN6x_ERR_OK
+ * else error
+ */
+uint8_t SEN6x::I2C_ReadFrame(uint8_t count)
+{
+  uint8_t exp_cnt, rec_cnt;
+
+  _Receive_BUF_Length = 0;
+
+  // 2 data bytes  + crc
+  exp_cnt = count / 2 * 3;
+
+  _transport->read(_I2CAddress, _Receive_BUF, exp_cnt, &rec_cnt);
+
+  // count the read for the clock fallback
+  ClockCheck(false);
+
+  SEN6x_STAT(_Stats.bytesReceived += rec_cnt);
+
+  if (rec_cnt != exp_cnt ){
+    DBPRINT2("Did not receive all bytes: Expected 0x%02X, got 0x%02X\r\n",exp_cnt & 0xff,rec_cnt & 0xff);
+    SEN6x_STAT(_Stats.shortReads++);
+    ClockCheck(true);
+    return(SEN6x_ERR_PROTOCOL);
+  }
+
+  if (SEN6x_CheckFrame(_Receive_BUF, rec_cnt) != rec_cnt / 3) {
+    DBPRINT("I2C CRC error in frame\r\n");
+    SEN6x_STAT(_Stats.crcErrors++);
+    ClockCheck(true);
+    return(SEN6x_ERR_PROTOCOL);
+  }
+
+  _Receive_BUF_Length = rec_cnt;
+
+  return(SEN6x_ERR_OK);
+}
+
 /**
  * @brief : calculate CRC for I2c comms
  * @param data : 2 databytes to calculate the CRC from
  *
- * Source : datasheet SEN6x
+ * Source : datasheet SEN6x (table driven, see sen6x_crc.cpp)
  *
  * @return CRC
  */
 uint8_t SEN6x::I2C_calc_CRC(uint8_t data[2])
 {
-  uint8_t crc = 0xFF;
-  for(int i = 0; i < 2; i++) {
-    crc ^= data[i];
-    for(uint8_t bit = 8; bit > 0; --bit) {
-      if(crc & 0x80) {
-        crc = (crc << 1) ^ 0x31u;
-      } else {
-        crc = (crc << 1);
-      }
-    }
-  }
-
-  return crc;
+  return(SEN6x_CRC(data));
 }
@@ -23,23 +23,63 @@
  * Version DRAFT 1.10 / January 2026 / paulvha
  * - updated to support UNOQ
  * - changed DEBUG display routines
+ *
+ * Version 1.11 / October 2026 / paulvha
+ * - added split-phase (non-blocking) transaction engine
+ * - added execution time for each command
+ * - added transport interface (sen6x_transport.h)
+ * - can be build on a Linux host with i2c-dev (sen6x_linux.h)
+ * - added SEN6x simulator (sen6x_sim.h)
+ * - added configurable I2C clock with automatic fallback
+ * - table driven CRC and whole frame check (sen6x_crc.h)
+ * - measured values are decoded straight from the received frame
+ * - added compile-time device driver SEN6xT<device> (sen6x_template.h)
+ * - command and error tables in flash, error text on all boards
+ * - frame layout tables and one decoder (Sen6xLayouts.h), invalid is NAN
+ * - added GetSnapshot()
+ * - added GetValuesFixed() and GetConcentrationFixed() (no float)
+ * - added multi-sensor manager SEN6xMulti for TCA9548A (sen6x_multi.h)
+ * - added cadence-locked sampler SEN6xSampler (sen6x_sampler.h)
+ * - added beginConfig() / commit() to stop and restart once for many settings
+ * - volatile configuration is cached, ClearCache()
+ * - added VOC algorithm state checkpoint SEN6xCheckpoint (sen6x_checkpoint.h)
+ * - added sample history SEN6xHistory (sen6x_history.h)
+ * - added rolling window statistics SEN6xStats (sen6x_stats.h)
+ * - added air quality index SEN6xAQI (sen6x_aqi.h)
+ * - added binary encoder SEN6xEncoder, packed or CBOR (sen6x_encode.h)
+ * - added GetMeta() : time, sequence, latency and age of measured values
+ * - added driver statistics (SEN6x_STATISTICS), GetStatistics()
+ * - added retry with backoff (SetRetry()) and I2C bus recovery (RecoverBus())
  *********************************************************************
 */
 #ifndef SEN6x_H
 #define SEN6x_H
 
-#include <Arduino.h>                // Needed for Stream
+/**
+ * The library can also be build on a host (e.g. Linux) without
+ * the Arduino core. (see sen6x_host.h and sen6x_linux.h)
+ */
+#if defined ARDUINO
+  #include <Arduino.h>                // Needed for Stream
+#else
+  #define SEN6x_HOST 1
+  #include "sen6x_host.h"
+#endif
 
 /**
  * library version levels
  */
 #define DRIVER_MAJOR_6x 1
-#define DRIVER_MINOR_6x 10
+#define DRIVER_MINOR_6x 11
 
 /**
  * select default debug serial
  */
-#define SEN6x_DEBUGSERIAL Serial
+#if defined SEN6x_HOST
+  #define SEN6x_DEBUGSERIAL SEN6xHostSerial
+#else
+  #define SEN6x_DEBUGSERIAL Serial
+#endif
 
 /**
  * If the platform is an ESP32 AND it is planned to connect an SCD30 as well,
@@ -52,7 +92,15 @@
  */
 //#define SCD30_SEN6x_ESP32 1
 
-#if defined SCD30_SEN6x_ESP32   // in case of use in combination with SCD30
+/**
+ * To count the commands, their latency, the bytes transferred and the
+ * errors of the driver (see GetStatistics()) you have to remove the
+ * comments from the line below. Without it there is no code or RAM used.
+ */
+//#define SEN6x_STATISTICS 1
+
+#if defined SEN6x_HOST          // no TwoWire, use a transport
+#elif defined SCD30_SEN6x_ESP32   // in case of use in combination with SCD30
   #include <SoftWire/SoftWire.h>
 #else
   #include "Wire.h"            // for I2c
@@ -66,6 +114,25 @@
   #define SMALLFOOTPRINT 1
 #endif
 
+/**
+ * Constant tables (opcodes, error text, CRC) are kept in flash on AVR
+ * and read with SEN6x_READ_BYTE / SEN6x_READ_WORD / SEN6x_STRNCPY.
+ * Other boards keep const data in flash without special access.
+ */
+#if defined(__AVR__)
+  #include <avr/pgmspace.h>
+  #define SEN6x_READ_BYTE(x)        pgm_read_byte(x)
+  #define SEN6x_READ_WORD(x)        pgm_read_word(x)
+  #define SEN6x_STRNCPY(d, s, n)    strncpy_P(d, s, n)
+#else
+  #ifndef PROGMEM
+    #define PROGMEM
+  #endif
+  #define SEN6x_READ_BYTE(x)        (*(const uint8_t *)(x))
+  #define SEN6x_READ_WORD(x)        (*(const uint16_t *)(x))
+  #define SEN6x_STRNCPY(d, s, n)    strncpy(d, s, n)
+#endif
+
 /**
  * An AVR has 32 I2C buffer. For reading values that is enough, but the Serial number and name, both can have 32 characters. As
  * after each 2 characters a CRC-byte is added, the total to read becomes 48. Thus reading will fail.
@@ -79,7 +146,9 @@
   #define SEN6x_MAX_32_TO_EXPECT 1
 #endif
 
-/* structure to return mass values */
+/* structure to return mass values
+ * A value the sensor reports as unknown (e.g. just after start) is NAN.
+ * (CO2 remains 0xFFFF) */
 struct sen6x_values {
   float   MassPM1;        // Mass Concentration PM1.0 [μg/m3]     ALL
   float   MassPM2;        // Mass Concentration PM2.5 [μg/m3]     ALL
@@ -114,6 +183,70 @@ struct sen6x_concentration_values {
   float   NumPM10;        // Number Concentration PM4.0 [#/cm3]   ALL
 };
 
+/* structure to return mass values as integers in the resolution of the
+ * sensor (no float). A value the sensor reports as unknown is 0xFFFF
+ * (0x7FFF for Hum, Temp, VOC and NOX).
+ * KEEP THE ORDER OF struct sen6x_values (see Sen6xLayouts.h) */
+struct sen6x_values_fixed {
+  uint16_t MassPM1;       // Mass Concentration PM1.0 [0.1 μg/m3] ALL
+  uint16_t MassPM2;       // Mass Concentration PM2.5 [0.1 μg/m3] ALL
+  uint16_t MassPM4;       // Mass Concentration PM4.0 [0.1 μg/m3] ALL
+  uint16_t MassPM10;      // Mass Concentration PM10 [0.1 μg/m3]  ALL
+  uint16_t NumPM0;        // Number Concentration PM0.5 [0.1 #/cm3] SEN60
+  uint16_t NumPM1;        // Number Concentration PM1.0 [0.1 #/cm3] SEN60
+  uint16_t NumPM2;        // Number Concentration PM2.5 [0.1 #/cm3] SEN60
+  uint16_t NumPM4;        // Number Concentration PM4.0 [0.1 #/cm3] SEN60
+  uint16_t NumPM10;       // Number Concentration PM10 [0.1 #/cm3]  SEN60
+  int16_t  Hum;           // Compensated Ambient Humidity [0.01 %RH]  SEN63C SEN65 SEN66 SEN68
+  int16_t  Temp;          // Compensated Ambient Temperature [0.005 °C] SEN63C SEN65 SEN66 SEN68
+  int16_t  VOC;           // VOC Index x 10 SEN65 SEN66 SEN68
+  int16_t  NOX;           // NOx Index x 10 SEN65 SEN66 SEN68
+  uint16_t CO2;           // CO2 concentration [ppm]  SEN63C SEN66
+  uint16_t HCHO;          // HCHO concentration [0.1 ppb] SEN68
+};
+
+struct sen6x_concentration_fixed {
+  uint16_t NumPM0;        // Number Concentration PM0.5 [0.1 #/cm3] ALL
+  uint16_t NumPM1;        // Number Concentration PM1.0 [0.1 #/cm3] ALL
+  uint16_t NumPM2;        // Number Concentration PM2.5 [0.1 #/cm3] ALL
+  uint16_t NumPM4;        // Number Concentration PM4.0 [0.1 #/cm3] ALL
+  uint16_t NumPM10;       // Number Concentration PM10 [0.1 #/cm3]  ALL
+};
+
+/**
+ * @brief : convert a fixed value to float (unknown is NAN)
+ *
+ * @param v     : value from sen6x_values_fixed or sen6x_concentration_fixed
+ * @param scale : 10 (PM, VOC, NOX, HCHO), 100 (Hum), 200 (Temp), 1 (CO2)
+ *
+ * e.g. SEN6x_ToFloat(val.Temp, 200)
+ */
+inline float SEN6x_ToFloat(uint16_t v, uint8_t scale) {
+  return(v == 0xFFFF ? NAN : v / (float) scale);
+}
+
+inline float SEN6x_ToFloat(int16_t v, uint8_t scale) {
+  return(v == 0x7FFF ? NAN : v / (float) scale);
+}
+
+/* structure to return all results of one measurement cycle */
+struct sen6x_snapshot {
+  struct sen6x_values values;
+  struct sen6x_concentration_values conc;
+  struct sen6x_raw_values raw;                // SEN60 : zero
+  uint16_t status;                            // see GetStatusReg()
+};
+
+/* metadata of the last measured values read (see GetMeta()) */
+#define SEN6x_META_UNKNOWN  (~0UL)
+
+struct sen6x_meta {
+  unsigned long time;     // time source when the values were received
+  uint32_t seq;           // number of the measurement of the sensor
+  unsigned long latency;  // from sending the command to values received
+  unsigned long age;      // from data ready seen to values received
+};
+
 /**
  * Obtain different version levels
  */
@@ -174,6 +307,25 @@ struct sen6x_xox {
   int16_t GainFactor;
 };
 
+/**
+ * copy of the volatile configuration as last written to or read
+ * from the SEN6x (see ClearCache())
+ */
+#define SEN6x_SHADOW_VOC      0x01
+#define SEN6x_SHADOW_NOX      0x02
+#define SEN6x_SHADOW_ASC      0x04
+#define SEN6x_SHADOW_PRESSURE 0x08
+#define SEN6x_SHADOW_ALTITUDE 0x10
+
+struct sen6x_shadow {
+  uint8_t valid;                // SEN6x_SHADOW_xxx of fields that are valid
+  struct sen6x_xox voc;
+  struct sen6x_xox nox;
+  bool asc;
+  uint16_t pressure;
+  uint16_t altitude;
+};
+
 /**
  * Temperature compensation
  * More details about the tuning of these parameters are included
@@ -230,14 +382,11 @@ struct sen6x_RHT_comp {
   uint16_t T2;
 };
 
-#ifndef SMALLFOOTPRINT
-
-  // error description
-  struct SEN6x_Description {
-    uint8_t code;
-    char    desc[80];
-  };
-#endif
+// error description (table in flash)
+struct SEN6x_Description {
+  uint8_t code;
+  char    desc[64];
+};
 
 /*************************************************************/
 
@@ -301,6 +450,48 @@ enum Sen6x_Comds_offset {
  /** expect something for the H2HO in the near future */
 };
 
+/**
+ * Command table entry (table in Sen6xCommands.h)
+ */
+struct sen6x_command {
+  uint16_t opcode;        // 0x0000 : command not supported
+  uint16_t exectime;      // execution time on the device in mS
+};
+
+#if defined SEN6x_STATISTICS
+/**
+ * driver statistics (see GetStatistics())
+ *
+ * latency : from sending the command to the answer received (or the
+ * execution time passed). Bucket i counts the latency up to
+ * SEN6x_LATENCY_BOUNDS[i] mS, the last bucket everything above.
+ */
+#define SEN6x_LATENCY_BUCKETS   8
+#define SEN6x_LATENCY_BOUNDS    {10, 25, 50, 100, 250, 1000, 2000, 0xFFFF}
+
+struct sen6x_cmd_statistics {
+  uint32_t count;         // commands sent
+  uint16_t errors;        // commands failed
+  uint16_t latency[SEN6x_LATENCY_BUCKETS];
+};
+
+struct sen6x_statistics {
+  struct sen6x_cmd_statistics cmd[SEN6x_GET_SET_ALTITUDE + 1];  // Sen6x_Comds_offset
+  uint32_t bytesSent;     // data bytes written (command + parameters)
+  uint32_t bytesReceived; // data bytes read (incl. CRC)
+  uint16_t writeErrors;   // command not acknowledged
+  uint16_t crcErrors;     // frames with a CRC error
+  uint16_t shortReads;    // less bytes received than expected
+  uint16_t lengthErrors;  // SEN6x_ERR_DATALENGTH
+  uint16_t retries;       // commands send again (SetRetry())
+  uint16_t recovers;      // I2C bus recovered (RecoverBus())
+  uint16_t stops;         // measurement stopped for a command (CheckToStop)
+  uint16_t restarts;      // measurement restarted (CheckWasStarted)
+  uint32_t delayTime;     // mS waiting for the first measurement after restart
+  uint32_t waitTime;      // mS blocked waiting for a command to execute
+};
+#endif
+
 /**
  * error codes
  */
@@ -313,8 +504,51 @@ enum Sen6x_Comds_offset {
 #define SEN6x_ERR_CMDSTATE            0x43
 #define SEN6x_ERR_TIMEOUT             0x50
 #define SEN6x_ERR_PROTOCOL            0x51
+#define SEN6x_ERR_STORAGE             0x60
 #define SEN6x_ERR_FIRMWARE            0x88
 
+/**
+ * transaction states (see submit() and poll())
+ */
+#define SEN6x_TRANS_IDLE              0
+#define SEN6x_TRANS_BUSY              1
+#define SEN6x_TRANS_DONE              2
+
+/**
+ * data ready as last seen (see GetMeta())
+ */
+#define SEN6x_RDY_UNKNOWN             0
+#define SEN6x_RDY_NOT                 1
+#define SEN6x_RDY_SEEN                2
+
+/**
+ * I2C clock. The SEN6x supports standard and fast mode.
+ *
+ * If within SEN6x_FALLBACK_WINDOW reads SEN6x_FALLBACK_ERRORS CRC or
+ * short-read errors happen, the clock falls back to standard mode
+ * (see SetClockFallback())
+ */
+#define SEN6x_CLOCK_STANDARD          100000
+#define SEN6x_CLOCK_FAST              400000
+#define SEN6x_CLOCK_MIN               10000
+#define SEN6x_FALLBACK_ERRORS         3
+#define SEN6x_FALLBACK_WINDOW         32
+
+/**
+ * A command that fails on the I2C bus (no acknowledge, CRC error or
+ * short read) is send again up to SEN6x_RETRIES times. The backoff
+ * before a retry starts at SEN6x_BACKOFF mS and doubles with each retry
+ * (see SetRetry())
+ */
+#define SEN6x_RETRIES                 2
+#define SEN6x_BACKOFF                 10
+
+/**
+ * mS after a restart by the library before the first measurement is
+ * ready (yield() is called while waiting)
+ */
+#define SEN6x_START_WAIT              1000
+
 // Receive buffer length.
 // in case of name / serial number the max is 32 + 16 CRC = 48
 #define SEN6x_MAXBUFLENGTH            50
@@ -326,6 +560,12 @@ enum Sen6x_Comds_offset {
 // set default device assumed to be connected
 #define DEFAULTDEVICE SEN66
 
+// transport interface (TwoWire or other)
+#include "sen6x_transport.h"
+
+// CRC-8 routines
+#include "sen6x_crc.h"
+
 class SEN6x
 {
   public:
@@ -380,7 +620,24 @@ class SEN6x
      *
      * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
      */
+#if not defined SEN6x_HOST
     bool begin(TwoWire *wirePort);
+#endif
+
+    /**
+     * @brief : Begin with assigment of a transport
+     *
+     * @param transport: transport to be used (see sen6x_transport.h)
+     *
+     * User must have initialized the transport in the sketch.
+     *
+     * @return
+     * true : device was correctly autodetected
+     * false : device was not detected (either no match or device not found)
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    bool begin(SEN6xTransport *transport);
 
     /**
      * @brief : Perform SEN6x instructions
@@ -393,6 +650,31 @@ class SEN6x
     bool stop();
     bool clean();
 
+    /**
+     * @brief : batch configuration calls
+     *
+     * Each configuration call (e.g. SetVocAlgorithm(), SetAltitude(),
+     * GetCo2SelfCalibratrion()) stops the measurement and restarts it
+     * afterwards, which takes about 2 seconds per call.
+     *
+     * beginConfig() stops the measurement once. The configuration calls
+     * that follow are executed straight away, back to back, with only
+     * the execution time of each command. commit() restarts the
+     * measurement once, if it was running at beginConfig().
+     *
+     * Reading values (GetValues() etc.) is not possible between
+     * beginConfig() and commit().
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_CMDSTATE : beginConfig() already called / commit() without beginConfig()
+     *  SEN6x_ERR_PROTOCOL : could not stop / start measurement
+     */
+    uint8_t beginConfig();
+    uint8_t commit();
+
     /**
      * @brief : retrieve Error message details
      *
@@ -400,6 +682,87 @@ class SEN6x
      */
     void GetErrDescription(uint8_t code, char *buf, int len);
 
+    /**
+     * @brief : set the I2C clock
+     *
+     * @param clock : SEN6x_CLOCK_MIN to SEN6x_CLOCK_FAST (default
+     * SEN6x_CLOCK_STANDARD). Can be called before begin().
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : clock out of range
+     *  SEN6x_ERR_UNKNOWNCMD : transport can not set clock
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t SetClock(uint32_t clock);
+
+    /**
+     * @brief : get the current I2C clock
+     *
+     * Can be lower than set with SetClock() after a fallback
+     */
+    uint32_t GetClock();
+
+    /**
+     * @brief : set when to fall back to standard mode
+     *
+     * @param errors : number of CRC or short-read errors (0 = never fall back)
+     * @param window : within this number of reads
+     *
+     * default : SEN6x_FALLBACK_ERRORS within SEN6x_FALLBACK_WINDOW
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void SetClockFallback(uint8_t errors, uint8_t window);
+
+    /**
+     * @brief : set the retry policy
+     *
+     * A command that fails on the I2C bus (no acknowledge, CRC error or
+     * short read) is send again after a backoff. Commands that can not
+     * be executed twice (start, stop, reset, read and clear status,
+     * fan cleaning, SHT heater, forced CO2 calibration) are not retried.
+     * If the command could not be written, the bus is recovered first
+     * (see RecoverBus()).
+     *
+     * @param retries : number of retries (0 = no retry)
+     * @param backoff : mS before the first retry, doubles with each retry
+     *
+     * default : SEN6x_RETRIES with SEN6x_BACKOFF
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void SetRetry(uint8_t retries, uint16_t backoff = SEN6x_BACKOFF);
+
+    /**
+     * @brief : recover the I2C bus
+     *
+     * A device that was interrupted in a transfer can hold SDA low. SCL
+     * is clocked until SDA is released, followed by a stop condition.
+     * The I2C clock is set again afterwards.
+     *
+     * With begin(TwoWire *) the pins must be set with SetBusPins().
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_UNKNOWNCMD : transport can not recover (or no pins set)
+     *  SEN6x_ERR_PROTOCOL : bus is still held low
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t RecoverBus();
+
+#if not defined SEN6x_HOST
+    /**
+     * @brief : set the pins of the TwoWire port for RecoverBus()
+     *
+     * @param scl : SCL pin
+     * @param sda : SDA pin
+     */
+    void SetBusPins(uint8_t scl, uint8_t sda);
+#endif
+
     /**
      * @brief : retrieve device information from the sen6x
      *
@@ -491,6 +854,148 @@ class SEN6x
      */
     uint8_t GetRawValues(struct sen6x_raw_values *v);
 
+    /**
+     * @brief : retrieve measurement values / PM number values as
+     * integers in the resolution of the sensor. No float is used.
+     * (see struct sen6x_values_fixed and SEN6x_ToFloat())
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  else error
+     */
+    uint8_t GetValuesFixed(struct sen6x_values_fixed *v);
+    uint8_t GetConcentrationFixed(struct sen6x_concentration_fixed *v);
+
+    /**
+     * @brief : retrieve values, PM numbers, raw values and status from
+     * the same measurement cycle.
+     *
+     * Only the commands the sensor supports are executed, each once (e.g.
+     * SEN60 : measured values and status). The next command is started
+     * before the previous answer is decoded.
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_OUTOFRANGE, values are read, but status has errors
+     *  else error (snapshot is zero)
+     */
+    uint8_t GetSnapshot(struct sen6x_snapshot *s);
+
+    /**
+     * @brief : metadata of the last measured values read
+     *
+     * GetValues(), GetValuesFixed(), GetSnapshot() and a completed
+     * SEN6x_READ_MEASURED_VALUE transaction update the metadata. No
+     * extra command is sent to the sensor.
+     *
+     *  time    : time source when the values were received
+     *  seq     : number of the measurement of the sensor (one per second).
+     *            The same seq as the previous read : the values were read
+     *            before (duplicate). A step of more than 1 : measurements
+     *            were missed.
+     *  latency : from sending the command to the values received
+     *  age     : from data ready seen (CheckDataReady()) to the values
+     *            received. SEN6x_META_UNKNOWN if data ready was not seen.
+     *
+     * seq uses data ready when it was checked since the previous read,
+     * else the time since the previous read.
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void GetMeta(struct sen6x_meta *m);
+
+    /**
+     * @brief : set the time source of the metadata
+     *
+     * @param src  : function that returns the time (default millis)
+     * @param rate : ticks of src per second (millis 1000, micros 1000000)
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void SetTimeSource(unsigned long (*src)(void), unsigned long rate = 1000);
+
+#if defined SEN6x_STATISTICS
+    /**
+     * @brief : driver statistics since begin() or ClearStatistics()
+     *
+     * Only available with SEN6x_STATISTICS defined (see top of this file)
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void GetStatistics(struct sen6x_statistics *s);
+    void ClearStatistics();
+#endif
+
+    /**
+     * @brief : split-phase (non-blocking) command execution
+     *
+     * submit() sends the command to the SEN6x and returns straight away.
+     * poll() has to be called regularly from the sketch loop. Once the
+     * execution time of the command has passed, poll() will read the
+     * answer from the SEN6x and the transaction is complete.
+     *
+     * Only one transaction can be pending. Do not call other (blocking)
+     * routines of the library while a transaction is pending.
+     * submit() will NOT start the measurement. Make sure start() was called
+     * before submitting a command to read measurement results.
+     *
+     * @param req : command to execute. Commands that need parameters
+     * (SEN6x_TEMP_OFFSET, SEN6x_TEMP_ACC_PARAM, SEN6x_FORCE_C02_CAL) can not
+     * be submitted. For the GET_SET-commands the GET is executed.
+     *
+     * submit() return :
+     *  SEN6x_ERR_OK = command was sent
+     *  SEN6x_ERR_CMDSTATE = other transaction still pending
+     *  else error
+     *
+     * poll() return :
+     *  true  : transaction is complete (or there is no transaction pending)
+     *  false : transaction is still pending
+     *
+     * result() return :
+     *  SEN6x_ERR_CMDSTATE : transaction still pending
+     *  SEN6x_ERR_OK : transaction was completed correctly
+     *  else error
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t submit(Sen6x_Comds_offset req);
+    bool poll();
+    uint8_t result();
+
+    /**
+     * @brief : decode the result of a completed transaction
+     *
+     * To be called after poll() has returned true for a transaction
+     * that was submitted with:
+     *
+     * ParseDataReady     : SEN6x_READ_DATA_RDY_FLAG
+     * ParseValues        : SEN6x_READ_MEASURED_VALUE
+     * ParseValuesFixed   : SEN6x_READ_MEASURED_VALUE
+     * ParseConcentration : SEN6x_NUM_CONC_VALUES (SEN60 : SEN6x_READ_MEASURED_VALUE)
+     * ParseConcentrationFixed : as ParseConcentration
+     * ParseRawValues     : SEN6x_READ_RAW_VALUE
+     * ParseStatusReg     : SEN6x_READ_DEVICE_REGISTER or SEN6x_RD_CL_DEVICE_REGISTER
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_CMDSTATE : no (matching) completed transaction
+     *  else error (see GetStatusReg() for ParseStatusReg)
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t ParseDataReady(bool *ready);
+    uint8_t ParseValues(struct sen6x_values *v);
+    uint8_t ParseConcentration(struct sen6x_concentration_values *v);
+    uint8_t ParseValuesFixed(struct sen6x_values_fixed *v);
+    uint8_t ParseConcentrationFixed(struct sen6x_concentration_fixed *v);
+    uint8_t ParseRawValues(struct sen6x_raw_values *v);
+    uint8_t ParseStatusReg(uint16_t *status);
+
     /**
      * @brief : save or restore the VOC algorithm
      *
@@ -671,6 +1176,24 @@ class SEN6x
      uint8_t GetAltitude(uint16_t *val);
      uint8_t SetAltitude(uint16_t val);
 
+    /**
+     * @brief : forget the cached configuration
+     *
+     * The VOC and NOx tuning, CO2 self calibration, ambient pressure and
+     * altitude are volatile. The library keeps a copy of what was last
+     * written or read. A Get-call is answered from that copy and a
+     * Set-call with the same value is not send, so no stop / restart
+     * of the measurement is needed.
+     *
+     * The copy is cleared on begin(), SetDevice(), reset() and when a
+     * transaction fails (e.g. the sensor lost power and NACKs the read of
+     * values). Call ClearCache() to force the next calls to read / write
+     * the sensor.
+     *
+     * Applies to: SEN60, SEN63C, SEN65, SEN66, SEN68
+     */
+    void ClearCache();
+
 
   private:
     /** debug */
@@ -693,6 +1216,9 @@ class SEN6x
     bool _deviceDetected;         // true : device was automatically detected
     bool _restart;                // whether to restart after executing command
     bool _started;                // indicate the measurement has started
+    bool _config;                 // between beginConfig() and commit()
+    bool _configRestart;          // restart measurement on commit()
+    struct sen6x_shadow _Shadow;  // copy of volatile configuration
     uint8_t _FW_Major, _FW_Minor; // holds sensor firmware level
 
     int _idata16;                 // data in i2c_fill_buffer
@@ -701,15 +1227,60 @@ class SEN6x
 
     uint16_t cmd;
 
+    /** transaction engine */
+    uint8_t _TransState;          // SEN6x_TRANS_IDLE, _BUSY or _DONE
+    uint8_t _TransResult;         // result of the last transaction
+    uint8_t _TransCnt;            // number of data bytes to read
+    bool _TransChkZero;           // check for zero termination
+    Sen6x_Comds_offset _TransReq; // command of the transaction
+    unsigned long _TransStart;    // millis() when command was sent
+    uint16_t _TransWait;          // execution time of the command (ms)
+    bool _TransRaw;               // keep received frame (no CRC removal)
+    unsigned long _TransSubmit;   // millis() when transaction was submitted
+    uint8_t _TransTry;            // retries done
+    bool _TransResend;            // send the command again after _TransWait
+    uint8_t _Retries;             // retries allowed (0 = disabled)
+    uint16_t _Backoff;            // mS before the first retry
+    bool CommandRetry(Sen6x_Comds_offset req);
+
+    /** metadata of measured values */
+    unsigned long (*_TimeSrc)(void);
+    unsigned long _TimeRate;      // ticks of _TimeSrc per second
+    unsigned long _TimeSent;      // _TimeSrc when command was sent
+    unsigned long _MetaReady;     // _TimeSrc when data ready state was seen
+    uint8_t _MetaState;           // SEN6x_RDY_xxx
+    bool _MetaFirst;              // no values read since start
+    struct sen6x_meta _Meta;
+    void Meta();
+
+#if defined SEN6x_STATISTICS
+    /** driver statistics */
+    struct sen6x_statistics _Stats;
+    void StatCommand(Sen6x_Comds_offset req, unsigned long ms, bool error);
+#endif
+
+    /** I2C clock */
+    uint32_t _Clock;              // current clock
+    uint8_t _ClkErrors;           // CRC / short-read errors in window
+    uint8_t _ClkReads;            // reads in window
+    uint8_t _ClkMaxErrors;        // errors to fall back (0 = disabled)
+    uint8_t _ClkWindow;           // number of reads in window
+    void ClockCheck(bool error);
+
     /** shared supporting routines */
     bool FWCheck(uint8_t major, uint8_t minor);
 
     uint16_t LookupCommand(Sen6x_Comds_offset cmd);
     bool SetCommand(Sen6x_Comds_offset req);
     bool SendCommand(Sen6x_Comds_offset req);
+    uint8_t ReadLength(Sen6x_Comds_offset req);
+    uint16_t CommandWait(Sen6x_Comds_offset req);
+    uint8_t TransCheck(Sen6x_Comds_offset req);
 
     bool CheckToStop();
     bool CheckWasStarted();
+    void ShadowStore(uint8_t bit, void *shadow, const void *val, uint8_t len);
+    bool ShadowSame(uint8_t bit, const void *shadow, const void *val, uint8_t len);
     bool DetectDevice();
 
     /** translate/transform */
@@ -723,12 +1294,23 @@ class SEN6x
     int16_t byte_to_int16_t(int x);
 
     /** I2C communication */
+#if not defined SEN6x_HOST
     TwoWire *_i2cPort;                  // holds the I2C port
+    SEN6xTwoWire _TwoWire;              // transport for the I2C port
     void I2C_init();
+#endif
+    SEN6xTransport *_transport;         // holds the transport in use
     uint8_t I2C_fill_buffer(uint16_t cmd, void *val = NULL);
     uint8_t I2C_ReadToBuffer(uint8_t count, bool chk_zero);
-    uint8_t I2C_SetPointer_Read(uint8_t cnt, bool chk_zero = false);
+    uint8_t I2C_ReadFrame(uint8_t count);
+    uint8_t I2C_SetPointer_Read(Sen6x_Comds_offset req, uint8_t cnt, bool chk_zero = false);
     uint8_t I2C_SetPointer();
+    uint8_t I2C_SetPointer_Wait(Sen6x_Comds_offset req);
+    uint8_t I2C_Submit(Sen6x_Comds_offset req, uint8_t cnt, bool chk_zero = false);
+    bool I2C_Poll();
+    bool I2C_Retry(uint8_t ret, bool recover);
+    bool I2C_Complete(uint8_t ret);
+    uint8_t I2C_Wait();
     uint8_t I2C_calc_CRC(uint8_t data[2]);
 };
 #endif /* SEN6x_H */
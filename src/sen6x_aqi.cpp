@@ -0,0 +1,239 @@
+/**
+ * SEN6x Library air quality index file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * EPA AQI, EU CAQI and CO2 bands on moving averages of the measured
+ * values (see sen6x_aqi.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_aqi.h"
+
+/**
+ * EPA breakpoint : concentration (x 10) low - high => index low - high
+ */
+struct sen6x_aqi_bp {
+  uint16_t clo;
+  uint16_t chi;
+  uint16_t ilo;
+  uint16_t ihi;
+};
+
+#define SEN6x_EPA_ROWS  6
+
+// PM2.5 24 hour, μg/m3 truncated to 0.1 (2024 revision)
+const struct sen6x_aqi_bp EpaPM2[SEN6x_EPA_ROWS] PROGMEM =
+{
+  {0, 90, 0, 50},         {91, 354, 51, 100},     {355, 554, 101, 150},
+  {555, 1254, 151, 200},  {1255, 2254, 201, 300}, {2255, 3254, 301, 500}
+};
+
+// PM10 24 hour, μg/m3 truncated to integer
+const struct sen6x_aqi_bp EpaPM10[SEN6x_EPA_ROWS] PROGMEM =
+{
+  {0, 540, 0, 50},        {550, 1540, 51, 100},   {1550, 2540, 101, 150},
+  {2550, 3540, 151, 200}, {3550, 4240, 201, 300}, {4250, 6040, 301, 500}
+};
+
+// CAQI hourly grid : μg/m3 for index 0, 25, 50, 75 and 100
+const uint8_t CaqiPM2[5] PROGMEM = {0, 15, 30, 55, 110};
+const uint8_t CaqiPM10[5] PROGMEM = {0, 25, 50, 90, 180};
+
+/**
+ * @brief : EPA index of a concentration
+ *
+ * @param c10 : concentration x 10 (truncated)
+ */
+static uint16_t EpaIndex(const struct sen6x_aqi_bp *bp, uint16_t c10)
+{
+  uint16_t clo, chi, ilo, ihi;
+  uint8_t i;
+
+  for (i = 0; i < SEN6x_EPA_ROWS; i++) {
+    chi = SEN6x_READ_WORD(&bp[i].chi);
+
+    if (c10 <= chi) {
+      clo = SEN6x_READ_WORD(&bp[i].clo);
+      ilo = SEN6x_READ_WORD(&bp[i].ilo);
+      ihi = SEN6x_READ_WORD(&bp[i].ihi);
+
+      // rounded to nearest integer
+      return(ilo + ((uint32_t) (ihi - ilo) * (c10 - clo) * 2 / (chi - clo) + 1) / 2);
+    }
+  }
+
+  // beyond the index
+  return(500);
+}
+
+/**
+ * @brief : CAQI index of a concentration
+ *
+ * Above 100 the last part of the grid is extended.
+ */
+static uint16_t CaqiIndex(const uint8_t *grid, float c)
+{
+  float lo, hi, idx;
+  uint8_t i;
+
+  for (i = 1; i < 4; i++)
+    if (c <= SEN6x_READ_BYTE(&grid[i])) break;
+
+  lo = SEN6x_READ_BYTE(&grid[i - 1]);
+  hi = SEN6x_READ_BYTE(&grid[i]);
+  idx = (i - 1) * 25 + 25 * (c - lo) / (hi - lo) + 0.5;
+
+  return(idx > 0xFFFE ? 0xFFFE : (uint16_t) idx);
+}
+
+SEN6xAQI::SEN6xAQI(void)
+{
+  _Day.win.span = 3600000UL;
+  _Day.win.buckets = SEN6x_AQI_DAY;
+  _Day.fields = 2;
+  _Day.bkt = _DayBkt;
+  _Day.total = _DayTotal;
+
+  _Hour.win.span = 300000UL;
+  _Hour.win.buckets = SEN6x_AQI_HOUR;
+  _Hour.fields = 3;
+  _Hour.bkt = _HourBkt;
+  _Hour.total = _HourTotal;
+
+  clear();
+}
+
+void SEN6xAQI::clear(void)
+{
+  Clear(&_Day);
+  Clear(&_Hour);
+}
+
+void SEN6xAQI::add(const struct sen6x_values *v)
+{
+  add(v, millis());
+}
+
+/**
+ * @brief : add a sample to the averages
+ *
+ * CO2 that is not measured (0) or unknown (0xFFFF) is not counted.
+ */
+void SEN6xAQI::add(const struct sen6x_values *v, unsigned long t)
+{
+  float x[3];
+
+  x[SEN6x_AQI_PM2] = v->MassPM2;
+  x[SEN6x_AQI_PM10] = v->MassPM10;
+  x[SEN6x_AQI_CO2] = (v->CO2 == 0 || v->CO2 == 0xFFFF) ? NAN : v->CO2;
+
+  Add(&_Day, x, t);
+  Add(&_Hour, x, t);
+}
+
+/**
+ * @brief : get the indices
+ */
+bool SEN6xAQI::Get(struct sen6x_aqi *a)
+{
+  a->PM2_24h = Average(&_Day, SEN6x_AQI_PM2);
+  a->PM10_24h = Average(&_Day, SEN6x_AQI_PM10);
+  a->PM2_1h = Average(&_Hour, SEN6x_AQI_PM2);
+  a->PM10_1h = Average(&_Hour, SEN6x_AQI_PM10);
+  a->CO2_1h = Average(&_Hour, SEN6x_AQI_CO2);
+
+  a->epaPM2 = isnan(a->PM2_24h) ? SEN6x_AQI_UNKNOWN : EpaIndex(EpaPM2, a->PM2_24h > 6000 ? 60000 : (uint16_t) (a->PM2_24h * 10));
+  a->epaPM10 = isnan(a->PM10_24h) ? SEN6x_AQI_UNKNOWN : EpaIndex(EpaPM10, a->PM10_24h > 6000 ? 60000 : (uint16_t) a->PM10_24h * 10);
+  a->caqiPM2 = isnan(a->PM2_1h) ? SEN6x_AQI_UNKNOWN : CaqiIndex(CaqiPM2, a->PM2_1h);
+  a->caqiPM10 = isnan(a->PM10_1h) ? SEN6x_AQI_UNKNOWN : CaqiIndex(CaqiPM10, a->PM10_1h);
+
+  // highest known index
+  if (a->epaPM2 == SEN6x_AQI_UNKNOWN) a->epa = a->epaPM10;
+  else if (a->epaPM10 == SEN6x_AQI_UNKNOWN) a->epa = a->epaPM2;
+  else a->epa = a->epaPM2 > a->epaPM10 ? a->epaPM2 : a->epaPM10;
+
+  if (a->caqiPM2 == SEN6x_AQI_UNKNOWN) a->caqi = a->caqiPM10;
+  else if (a->caqiPM10 == SEN6x_AQI_UNKNOWN) a->caqi = a->caqiPM2;
+  else a->caqi = a->caqiPM2 > a->caqiPM10 ? a->caqiPM2 : a->caqiPM10;
+
+  if (isnan(a->CO2_1h)) a->co2 = SEN6x_CO2_UNKNOWN;
+  else if (a->CO2_1h <= 950) a->co2 = SEN6x_CO2_I;
+  else if (a->CO2_1h <= 1200) a->co2 = SEN6x_CO2_II;
+  else if (a->CO2_1h <= 1750) a->co2 = SEN6x_CO2_III;
+  else a->co2 = SEN6x_CO2_IV;
+
+  return(a->epa != SEN6x_AQI_UNKNOWN);
+}
+
+void SEN6xAQI::Clear(struct sen6x_avg_window *w)
+{
+  memset(w->bkt, 0x0, w->win.buckets * w->fields * sizeof(struct sen6x_avg));
+  memset(w->total, 0x0, w->fields * sizeof(struct sen6x_avg_total));
+  SEN6x_WindowClear(&w->win);
+}
+
+/**
+ * @brief : add a sample to the current bucket
+ *
+ * If the current bucket has ended, the window is moved first. After a
+ * gap of a window or more, the window is cleared.
+ */
+void SEN6xAQI::Add(struct sen6x_avg_window *w, const float *x, unsigned long t)
+{
+  uint8_t f, n;
+
+  n = SEN6x_WindowMoves(&w->win, t);
+
+  // start again at t
+  if (n == w->win.buckets) {
+    Clear(w);
+    SEN6x_WindowMoves(&w->win, t);
+  }
+  else
+    while (n-- > 0) Move(w);
+
+  for (f = 0; f < w->fields; f++) {
+    if (isnan(x[f])) continue;
+    SEN6x_AvgAdd(&w->bkt[f * w->win.buckets + w->win.cur], x[f]);
+  }
+}
+
+/**
+ * @brief : move the window one bucket
+ */
+void SEN6xAQI::Move(struct sen6x_avg_window *w)
+{
+  uint8_t f, cur = w->win.cur;
+  bool sum;
+
+  sum = SEN6x_WindowMove(&w->win);
+
+  for (f = 0; f < w->fields; f++) {
+    SEN6x_AvgMove(&w->total[f], &w->bkt[f * w->win.buckets], cur, w->win.cur);
+    if (sum) SEN6x_AvgSum(&w->total[f], &w->bkt[f * w->win.buckets], w->win.buckets, w->win.cur);
+  }
+}
+
+/**
+ * @brief : average of a field (NAN : no samples)
+ */
+float SEN6xAQI::Average(struct sen6x_avg_window *w, uint8_t f)
+{
+  return(SEN6x_AvgMean(&w->total[f], &w->bkt[f * w->win.buckets + w->win.cur]));
+}
@@ -0,0 +1,143 @@
+/**
+ * SEN6x Library air quality index header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xAQI turns the measured values into air quality indices :
+ *
+ *  - US EPA AQI (breakpoints of the 2024 revision) of PM2.5 and PM10,
+ *    on the 24 hour average.
+ *  - EU CAQI (Common Air Quality Index, hourly grid) of PM2.5 and PM10,
+ *    on the 1 hour average.
+ *  - CO2 band (SEN63C, SEN66) on the 1 hour average. The bands are the
+ *    categories of EN 16798-1 with 400 ppm outdoor CO2.
+ *
+ * The averages are kept with buckets and running sums : 24 buckets of
+ * 1 hour and 12 buckets of 5 minutes, about 800 bytes. Each sample takes
+ * the same (short) time, the averages move a bucket at a time. Until a
+ * window is filled, the average of the samples so far is used.
+ *
+ * The indices of ozone, NO2 and CO need gas concentrations that the
+ * SEN6x does not measure (the NOx and VOC index are not concentrations).
+ *
+ * Usage :
+ *
+ *  SEN6xAQI aqi;
+ *
+ *  loop() :
+ *  if (sen6x.GetValues(&val) == SEN6x_ERR_OK) aqi.add(&val);
+ *
+ *  if (aqi.Get(&idx)) Serial.print(idx.epa);
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_AQI_H
+#define SEN6x_AQI_H
+
+#include "sen6x_window.h"
+
+#define SEN6x_AQI_DAY           24        // buckets of 1 hour
+#define SEN6x_AQI_HOUR          12        // buckets of 5 minutes
+
+// averages
+#define SEN6x_AQI_PM2           0
+#define SEN6x_AQI_PM10          1
+#define SEN6x_AQI_CO2           2         // 1 hour only
+
+// CO2 bands (EN 16798-1 category)
+#define SEN6x_CO2_UNKNOWN       0         // no CO2 measured
+#define SEN6x_CO2_I             1         // <= 950 ppm  : high
+#define SEN6x_CO2_II            2         // <= 1200 ppm : normal
+#define SEN6x_CO2_III           3         // <= 1750 ppm : moderate
+#define SEN6x_CO2_IV            4         // > 1750 ppm  : low
+
+#define SEN6x_AQI_UNKNOWN       0xFFFF    // index without samples
+
+/**
+ * indices and the averages they are based on
+ */
+struct sen6x_aqi {
+  uint16_t epa;             // EPA AQI : highest of PM2.5 and PM10 (0 - 500)
+  uint16_t epaPM2;          // EPA AQI PM2.5
+  uint16_t epaPM10;         // EPA AQI PM10
+  uint16_t caqi;            // CAQI : highest of PM2.5 and PM10 (> 100 : very high)
+  uint16_t caqiPM2;         // CAQI PM2.5
+  uint16_t caqiPM10;        // CAQI PM10
+  uint8_t  co2;             // SEN6x_CO2_xxx
+  float    PM2_24h;         // 24 hour average PM2.5 [μg/m3]
+  float    PM10_24h;        // 24 hour average PM10 [μg/m3]
+  float    PM2_1h;          // 1 hour average PM2.5 [μg/m3]
+  float    PM10_1h;         // 1 hour average PM10 [μg/m3]
+  float    CO2_1h;          // 1 hour average CO2 [ppm]
+};
+
+/**
+ * moving averages of fields over a window (see sen6x_window.h)
+ */
+struct sen6x_avg_window {
+  struct sen6x_window win;
+  uint8_t fields;
+  struct sen6x_avg *bkt;                  // [field][bucket]
+  struct sen6x_avg_total *total;          // [field]
+};
+
+class SEN6xAQI
+{
+  public:
+
+    SEN6xAQI(void);
+
+    /**
+     * @brief : remove all samples
+     */
+    void clear(void);
+
+    /**
+     * @brief : add a sample
+     *
+     * @param v : measured values (see GetValues() in sen6x.h)
+     * @param t : time of the sample in mS (default millis())
+     */
+    void add(const struct sen6x_values *v);
+    void add(const struct sen6x_values *v, unsigned long t);
+
+    /**
+     * @brief : get the indices
+     *
+     * An index without samples is SEN6x_AQI_UNKNOWN, an average NAN.
+     *
+     * @return
+     *  true  : ok
+     *  false : no samples
+     */
+    bool Get(struct sen6x_aqi *a);
+
+  private:
+    struct sen6x_avg_window _Day;
+    struct sen6x_avg _DayBkt[SEN6x_AQI_DAY * 2];
+    struct sen6x_avg_total _DayTotal[2];
+
+    struct sen6x_avg_window _Hour;
+    struct sen6x_avg _HourBkt[SEN6x_AQI_HOUR * 3];
+    struct sen6x_avg_total _HourTotal[3];
+
+    void Add(struct sen6x_avg_window *w, const float *x, unsigned long t);
+    void Move(struct sen6x_avg_window *w);
+    void Clear(struct sen6x_avg_window *w);
+    float Average(struct sen6x_avg_window *w, uint8_t f);
+};
+
+#endif /* SEN6x_AQI_H */
@@ -0,0 +1,177 @@
+/**
+ * SEN6x Library VOC algorithm state checkpoint file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Saves the VOC algorithm state in a storage and restores it after a
+ * power cycle (see sen6x_checkpoint.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_checkpoint.h"
+
+#define SEN6x_CKPT_NONE   0xFF      // no slot saved
+
+SEN6xCheckpoint::SEN6xCheckpoint(SEN6x *sen6x, SEN6xStore *store, uint16_t base, uint8_t slots)
+{
+  _sen6x = sen6x;
+  _store = store;
+  _Base = base;
+  _Slots = slots == 0 || slots == SEN6x_CKPT_NONE ? 1 : slots;
+  _Slot = SEN6x_CKPT_NONE;
+  _Seq = 0;
+  _Restored = false;
+  _Interval = SEN6x_CKPT_INTERVAL * 1000UL;
+  _Last = 0;
+}
+
+/**
+ * @brief : find the last saved state and restore it in the sensor
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6xCheckpoint::begin()
+{
+  uint8_t slot, state[VOC_ALO_SIZE];
+  uint16_t seq;
+  uint8_t ret;
+
+  _Slot = SEN6x_CKPT_NONE;
+  _Restored = false;
+  _Last = millis();
+
+  for (slot = 0; slot < _Slots; slot++) {
+
+    if (! Load(slot, &seq, state)) continue;
+
+    // sequence numbers wrap around
+    if (_Slot == SEN6x_CKPT_NONE || (int16_t) (seq - _Seq) > 0) {
+      _Slot = slot;
+      _Seq = seq;
+      memcpy(_State, state, VOC_ALO_SIZE);
+    }
+  }
+
+  // nothing saved yet
+  if (_Slot == SEN6x_CKPT_NONE) return(SEN6x_ERR_OK);
+
+  ret = _sen6x->SetVocAlgorithmState(_State, VOC_ALO_SIZE);
+
+  if (ret == SEN6x_ERR_OK) _Restored = true;
+
+  return(ret);
+}
+
+void SEN6xCheckpoint::SetInterval(uint32_t seconds)
+{
+  _Interval = seconds * 1000UL;
+}
+
+bool SEN6xCheckpoint::IsRestored()
+{
+  return(_Restored);
+}
+
+/**
+ * @brief : save the state when the interval has passed
+ */
+uint8_t SEN6xCheckpoint::update()
+{
+  if (millis() - _Last < _Interval) return(SEN6x_ERR_OK);
+
+  _Last = millis();
+
+  return(save());
+}
+
+/**
+ * @brief : save the state in the next slot
+ *
+ * The state is written before the sequence number. If the write is
+ * interrupted the slot has the old (lowest) sequence number or a
+ * wrong CRC, and the previous slot is used by begin().
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6xCheckpoint::save()
+{
+  uint8_t rec[SEN6x_CKPT_RECORD];
+  uint8_t state[VOC_ALO_SIZE];
+  uint8_t ret, slot, i, j;
+  uint16_t addr;
+
+  ret = _sen6x->GetVocAlgorithmState(state, VOC_ALO_SIZE);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  // unchanged : no need to wear the storage
+  if (_Slot != SEN6x_CKPT_NONE && memcmp(state, _State, VOC_ALO_SIZE) == 0) return(SEN6x_ERR_OK);
+
+  slot = (_Slot == SEN6x_CKPT_NONE) ? 0 : (_Slot + 1) % _Slots;
+
+  rec[0] = (uint8_t) ((_Seq + 1) >> 8);
+  rec[1] = (uint8_t) ((_Seq + 1) & 0xFF);
+  rec[2] = SEN6x_CRC(rec);
+
+  for (i = 0, j = 3; i < VOC_ALO_SIZE; i += 2, j += 3) {
+    rec[j] = state[i];
+    rec[j + 1] = state[i + 1];
+    rec[j + 2] = SEN6x_CRC(&rec[j]);
+  }
+
+  addr = _Base + slot * SEN6x_CKPT_RECORD;
+
+  if (! _store->write(addr + 3, &rec[3], SEN6x_CKPT_RECORD - 3)) return(SEN6x_ERR_STORAGE);
+  if (! _store->write(addr, rec, 3)) return(SEN6x_ERR_STORAGE);
+  if (! _store->commit()) return(SEN6x_ERR_STORAGE);
+
+  _Slot = slot;
+  _Seq++;
+  memcpy(_State, state, VOC_ALO_SIZE);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : read a slot from the storage
+ *
+ * @return
+ *  true  : valid slot
+ *  false : empty, damaged or can not read
+ */
+bool SEN6xCheckpoint::Load(uint8_t slot, uint16_t *seq, uint8_t *state)
+{
+  uint8_t rec[SEN6x_CKPT_RECORD];
+  uint8_t i, j;
+
+  if (! _store->read(_Base + slot * SEN6x_CKPT_RECORD, rec, SEN6x_CKPT_RECORD)) return(false);
+
+  if (SEN6x_CheckFrame(rec, SEN6x_CKPT_RECORD) != SEN6x_CKPT_RECORD / 3) return(false);
+
+  *seq = (uint16_t) rec[0] << 8 | rec[1];
+
+  for (i = 0, j = 3; i < VOC_ALO_SIZE; i += 2, j += 3) {
+    state[i] = rec[j];
+    state[i + 1] = rec[j + 1];
+  }
+
+  return(true);
+}
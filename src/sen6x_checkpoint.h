@@ -0,0 +1,146 @@
+/**
+ * SEN6x Library VOC algorithm state checkpoint header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * The VOC algorithm of the SEN65, SEN66 and SEN68 learns for hours before
+ * the VOC index is reliable. After a power cycle the learning starts
+ * again, unless the VOC algorithm state is restored.
+ *
+ * SEN6xCheckpoint reads the VOC algorithm state while measuring (no stop
+ * is needed) every SEN6x_CKPT_INTERVAL seconds and saves it in a
+ * storage (see sen6x_store.h). begin() restores the last saved state in
+ * the sensor.
+ *
+ * Wear levelling : the storage has SEN6x_CKPT_SLOTS slots. Each save is
+ * written in the next slot with a sequence number, the slot with the
+ * highest sequence number holds the last state. Each slot is written
+ * once in SEN6x_CKPT_SLOTS saves. A state that did not change is not
+ * written. The state is written before the sequence number and each
+ * 2 bytes have a CRC, so a save that is interrupted by a power loss
+ * does not destroy the previous state.
+ *
+ * Storage needed : SEN6x_CKPT_SLOTS * SEN6x_CKPT_RECORD bytes
+ *
+ * Usage :
+ *
+ *  SEN6x sen6x;
+ *  SEN6xEEPROM eeprom;
+ *  SEN6xCheckpoint checkpoint(&sen6x, &eeprom);
+ *
+ *  setup() :
+ *  sen6x.begin(&Wire);
+ *  eeprom.begin();
+ *  checkpoint.begin();                // before start()
+ *  sen6x.start();
+ *
+ *  loop() :
+ *  checkpoint.update();
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_CHECKPOINT_H
+#define SEN6x_CHECKPOINT_H
+
+#include "sen6x_store.h"
+
+// default slots in storage (can be overruled before include)
+#ifndef SEN6x_CKPT_SLOTS
+  #define SEN6x_CKPT_SLOTS      8
+#endif
+
+// default seconds between saves, change with SetInterval()
+#define SEN6x_CKPT_INTERVAL     600
+
+// bytes in a slot : sequence number and state, each 2 bytes + CRC
+#define SEN6x_CKPT_RECORD       (3 + VOC_ALO_SIZE / 2 * 3)
+
+class SEN6xCheckpoint
+{
+  public:
+
+    /**
+     * @param sen6x : driver of the sensor (begin() must be called on it)
+     * @param store : storage to use
+     * @param base  : first byte in the storage to use
+     * @param slots : number of slots (1 - 255)
+     */
+    SEN6xCheckpoint(SEN6x *sen6x, SEN6xStore *store, uint16_t base = 0,
+                    uint8_t slots = SEN6x_CKPT_SLOTS);
+
+    /**
+     * @brief : restore the last saved state in the sensor
+     *
+     * Call before start(), the state can only be set in idle mode.
+     *
+     * Applies to: SEN65, SEN66, SEN68
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok (also if no state was saved, see IsRestored())
+     *  else error of SetVocAlgorithmState()
+     */
+    uint8_t begin();
+
+    /**
+     * @brief : set the seconds between saves (default SEN6x_CKPT_INTERVAL)
+     */
+    void SetInterval(uint32_t seconds);
+
+    /**
+     * @brief : save the state when the interval has passed
+     *
+     * Call regularly from loop().
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok (or nothing to do)
+     *  SEN6x_ERR_STORAGE : can not write storage
+     *  else error
+     */
+    uint8_t update();
+
+    /**
+     * @brief : save the state now
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_STORAGE : can not write storage
+     *  else error
+     */
+    uint8_t save();
+
+    /**
+     * @brief : true if begin() restored a state in the sensor
+     */
+    bool IsRestored();
+
+  private:
+    SEN6x *_sen6x;
+    SEN6xStore *_store;
+    uint16_t _Base;                       // first byte in storage
+    uint8_t _Slots;                       // number of slots
+
+    uint8_t _Slot;                        // slot of last save (0xFF none)
+    uint16_t _Seq;                        // sequence number of last save
+    uint8_t _State[VOC_ALO_SIZE];         // state of last save
+    bool _Restored;
+
+    unsigned long _Interval;              // mS between saves
+    unsigned long _Last;                  // millis() of last save
+
+    bool Load(uint8_t slot, uint16_t *seq, uint8_t *state);
+};
+
+#endif /* SEN6x_CHECKPOINT_H */
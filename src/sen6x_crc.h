@@ -0,0 +1,58 @@
+/**
+ * SEN6x Library CRC header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * CRC-8 as used by the SEN6x (polynomial 0x31, init 0xFF, no final XOR).
+ * Each 2 data bytes on the I2C bus are followed by a CRC.
+ *
+ * The CRC is table driven. On AVR the table (256 bytes) is placed
+ * in flash.
+ *
+ * The routines do not depend on the SEN6x class and can be used to
+ * check logged frames on a host.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ *
+ * This file is included from sen6x.h
+ */
+#ifndef SEN6x_CRC_H
+#define SEN6x_CRC_H
+
+/**
+ * @brief : calculate the CRC of 2 data bytes
+ *
+ * @param data : 2 data bytes
+ *
+ * @return CRC
+ */
+uint8_t SEN6x_CRC(const uint8_t *data);
+
+/**
+ * @brief : check the CRC of all 3-byte groups (2 data bytes + CRC)
+ * in a received frame in one pass
+ *
+ * @param frame : received frame
+ * @param len   : number of bytes in frame
+ *
+ * @return
+ *  number of groups, from the start of the frame, with a correct CRC.
+ *  Equal to len / 3 if all CRC's are correct. A partial group at the
+ *  end of the frame is not checked.
+ */
+uint8_t SEN6x_CheckFrame(const uint8_t *frame, uint8_t len);
+
+#endif /* SEN6x_CRC_H */
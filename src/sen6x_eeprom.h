@@ -0,0 +1,87 @@
+/**
+ * SEN6x Library EEPROM storage header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Storage (see sen6x_store.h) with the EEPROM library of the board. On
+ * ESP32, ESP8266 and RP2040 the EEPROM library emulates the EEPROM in
+ * a flash page. The data is written to flash with commit().
+ *
+ * Only include this file in a sketch for a board that has an EEPROM
+ * library.
+ *
+ * Usage :
+ *
+ *  SEN6xEEPROM eeprom;
+ *
+ *  setup() :
+ *  eeprom.begin();                    // ESP32, ESP8266, RP2040 : size
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_EEPROM_H
+#define SEN6x_EEPROM_H
+
+#include "sen6x_store.h"
+#include <EEPROM.h>
+
+// EEPROM emulated in flash : begin(size) and commit() are needed
+#if defined ARDUINO_ARCH_ESP32 || defined ARDUINO_ARCH_ESP8266 || defined ARDUINO_ARCH_RP2040
+  #define SEN6x_EEPROM_FLASH
+#endif
+
+class SEN6xEEPROM : public SEN6xStore
+{
+  public:
+
+    /**
+     * @brief : start the EEPROM
+     *
+     * @param size : bytes of EEPROM to use (flash emulation only)
+     */
+    void begin(uint16_t size = 512) {
+#if defined SEN6x_EEPROM_FLASH
+      EEPROM.begin(size);
+#else
+      (void) size;
+#endif
+    }
+
+    bool read(uint16_t addr, uint8_t *buf, uint8_t len) {
+      for (uint8_t i = 0; i < len; i++) buf[i] = EEPROM.read(addr + i);
+      return(true);
+    }
+
+    /**
+     * only bytes that changed are written (less wear)
+     */
+    bool write(uint16_t addr, const uint8_t *buf, uint8_t len) {
+      for (uint8_t i = 0; i < len; i++) {
+        if (EEPROM.read(addr + i) != buf[i]) EEPROM.write(addr + i, buf[i]);
+      }
+      return(true);
+    }
+
+    bool commit() {
+#if defined SEN6x_EEPROM_FLASH
+      return(EEPROM.commit());
+#else
+      return(true);
+#endif
+    }
+};
+
+#endif /* SEN6x_EEPROM_H */
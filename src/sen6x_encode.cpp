@@ -0,0 +1,320 @@
+/**
+ * SEN6x Library binary encoder file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Writes the results in packed binary or CBOR (see sen6x_encode.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_encode.h"
+#include "Sen6xLayouts.h"
+
+// CBOR major types and simple values
+#define CBOR_UINT       0
+#define CBOR_NEGINT     1
+#define CBOR_ARRAY      4
+#define CBOR_MAP        5
+#define CBOR_NULL       0xF6
+
+/**
+ * @brief : convert a structure with float fields to the words as received
+ *
+ * @param s      : structure
+ * @param layout : row of a layout table
+ * @param n      : number of entries in the row
+ * @param w      : to store the words (in the order of the row)
+ */
+static void SEN6x_ToWords(const void *s, const struct sen6x_field *layout, uint8_t n, uint16_t *w)
+{
+  static const uint8_t Scale[4] = {1, 10, 100, 200};
+  const uint8_t *d = (const uint8_t *) s;
+  uint8_t i, type;
+  float fl;
+
+  for (i = 0; i < n; i++) {
+    type = SEN6x_READ_BYTE(&layout[i].type);
+
+    if (type & SEN6x_L_FLOAT) {
+      memcpy(&fl, d + SEN6x_READ_BYTE(&layout[i].offset), sizeof(float));
+
+      if (isnan(fl))
+        w[i] = (type & SEN6x_L_SIGNED) ? 0x7FFF : 0xFFFF;
+      else {
+        fl *= Scale[type & SEN6x_L_SCALE];
+        w[i] = (type & SEN6x_L_SIGNED) ? (uint16_t) (int16_t) (fl < 0 ? fl - 0.5 : fl + 0.5) : (uint16_t) (fl + 0.5);
+      }
+    }
+    else
+      memcpy(&w[i], d + SEN6x_READ_BYTE(&layout[i].offset), sizeof(uint16_t));
+  }
+}
+
+SEN6xEncoder::SEN6xEncoder(void)
+{
+  _Buf = NULL;
+  _Size = _Len = 0;
+  _Device = SEN66;
+  _Format = SEN6x_ENC_PACKED;
+  _Parts = 0;
+  _Over = false;
+}
+
+/**
+ * @brief : start a new message with the header
+ */
+uint8_t SEN6xEncoder::begin(uint8_t *buf, uint16_t size, SEN6x_device d, uint8_t format)
+{
+  if (d > SEN68 || format > SEN6x_ENC_CBOR || buf == NULL) return(SEN6x_ERR_PARAMETER);
+
+  if (size < (format == SEN6x_ENC_CBOR ? 3 : 2)) return(SEN6x_ERR_DATALENGTH);
+
+  _Buf = buf;
+  _Size = size;
+  _Len = 0;
+  _Device = d;
+  _Format = format;
+  _Parts = 0;
+  _Over = false;
+
+  if (_Format == SEN6x_ENC_CBOR) {
+    PutCbor(CBOR_MAP, 1);               // updated by each part
+    PutCbor(CBOR_UINT, 0);
+    PutCbor(CBOR_UINT, SEN6x_ENC_VERSION << 4 | d);
+  }
+  else {
+    Put(SEN6x_ENC_VERSION << 4 | d);
+    Put(0);                             // updated by each part
+  }
+
+  return(SEN6x_ERR_OK);
+}
+
+uint16_t SEN6xEncoder::GetLength(void)
+{
+  return(_Len);
+}
+
+uint8_t SEN6xEncoder::values(const struct sen6x_values *v)
+{
+  uint16_t w[SEN6x_VALUES_FIELDS];
+
+  SEN6x_ToWords(v, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, w);
+
+  return(Part(SEN6x_ENC_VALUES, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, w, true, 0));
+}
+
+uint8_t SEN6xEncoder::values(const struct sen6x_values_fixed *v)
+{
+  return(Part(SEN6x_ENC_VALUES, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, (const uint16_t *) v, true, 0));
+}
+
+uint8_t SEN6xEncoder::conc(const struct sen6x_concentration_values *v)
+{
+  uint16_t w[SEN6x_CONC_FIELDS];
+
+  SEN6x_ToWords(v, SEN6xConcLayout[_Device], SEN6x_CONC_FIELDS, w);
+
+  return(Part(SEN6x_ENC_CONC, SEN6xConcLayout[_Device], SEN6x_CONC_FIELDS, w, true, 0));
+}
+
+uint8_t SEN6xEncoder::conc(const struct sen6x_concentration_fixed *v)
+{
+  return(Part(SEN6x_ENC_CONC, SEN6xConcLayout[_Device], SEN6x_CONC_FIELDS, (const uint16_t *) v, true, 0));
+}
+
+/**
+ * @brief : raw values are written as received (Hum and Temp signed)
+ */
+uint8_t SEN6xEncoder::raw(const struct sen6x_raw_values *v)
+{
+  uint16_t w[SEN6x_RAW_FIELDS];
+
+  if (_Device == SEN60) return(SEN6x_ERR_PARAMETER);
+
+  SEN6x_ToWords(v, SEN6xRawLayout[_Device], SEN6x_RAW_FIELDS, w);
+
+  return(Part(SEN6x_ENC_RAW, SEN6xRawLayout[_Device], SEN6x_RAW_FIELDS, w, false, 0x03));
+}
+
+uint8_t SEN6xEncoder::status(uint16_t status)
+{
+  uint16_t start;
+  uint8_t ret;
+
+  ret = Begin(SEN6x_ENC_STATUS, &start);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  if (_Format == SEN6x_ENC_CBOR) PutCbor(CBOR_UINT, status);
+  else PutWord(status);
+
+  return(End(SEN6x_ENC_STATUS, start));
+}
+
+uint8_t SEN6xEncoder::snapshot(const struct sen6x_snapshot *s)
+{
+  uint8_t ret;
+
+  ret = values(&s->values);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  ret = conc(&s->conc);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  if (_Device != SEN60) {
+    ret = raw(&s->raw);
+    if (ret != SEN6x_ERR_OK) return(ret);
+  }
+
+  return(status(s->status));
+}
+
+/**
+ * @brief : write the fields of a part the device provides
+ *
+ * @param layout  : row of a layout table
+ * @param n       : number of entries in the row
+ * @param w       : words in the order of the row
+ * @param invalid : write unknown (0xFFFF, signed 0x7FFF) as CBOR null
+ * @param sign    : bit i : field i is signed (else from layout)
+ */
+uint8_t SEN6xEncoder::Part(uint8_t part, const void *layout, uint8_t n, const uint16_t *w, bool invalid, uint8_t sign)
+{
+  const struct sen6x_field *l = (const struct sen6x_field *) layout;
+  uint16_t start;
+  uint8_t ret, i, cnt = 0;
+  bool sgn;
+
+  ret = Begin(part, &start);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  if (_Format == SEN6x_ENC_CBOR) {
+    for (i = 0; i < n; i++)
+      if (SEN6x_READ_BYTE(&l[i].word) != SEN6x_L_NONE) cnt++;
+
+    PutCbor(CBOR_ARRAY, cnt);
+  }
+
+  for (i = 0; i < n; i++) {
+
+    if (SEN6x_READ_BYTE(&l[i].word) == SEN6x_L_NONE) continue;
+
+    if (_Format == SEN6x_ENC_PACKED) {
+      PutWord(w[i]);
+      continue;
+    }
+
+    sgn = (SEN6x_READ_BYTE(&l[i].type) & SEN6x_L_SIGNED) || (sign & (1 << i));
+
+    if (invalid && w[i] == (sgn ? 0x7FFF : 0xFFFF))
+      Put(CBOR_NULL);
+    else
+      PutInt(w[i], sgn);
+  }
+
+  return(End(part, start));
+}
+
+/**
+ * @brief : check the order and write the key of a part
+ */
+uint8_t SEN6xEncoder::Begin(uint8_t part, uint16_t *start)
+{
+  uint8_t key = 1;
+
+  if (_Buf == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  // a later part was added already
+  if (_Parts >= part) return(SEN6x_ERR_PARAMETER);
+
+  *start = _Len;
+  _Over = false;
+
+  if (_Format == SEN6x_ENC_CBOR) {
+    while (part >>= 1) key++;
+    PutCbor(CBOR_UINT, key);
+  }
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : complete a part and update the header
+ *
+ * If the buffer was too small, the part is removed.
+ */
+uint8_t SEN6xEncoder::End(uint8_t part, uint16_t start)
+{
+  uint8_t pairs = 1, p;
+
+  if (_Over) {
+    _Len = start;
+    return(SEN6x_ERR_DATALENGTH);
+  }
+
+  _Parts |= part;
+
+  if (_Format == SEN6x_ENC_CBOR) {
+    for (p = _Parts; p; p >>= 1) pairs += p & 1;
+    _Buf[0] = CBOR_MAP << 5 | pairs;
+  }
+  else
+    _Buf[1] = _Parts;
+
+  return(SEN6x_ERR_OK);
+}
+
+void SEN6xEncoder::Put(uint8_t b)
+{
+  if (_Len < _Size) _Buf[_Len++] = b;
+  else _Over = true;
+}
+
+void SEN6xEncoder::PutWord(uint16_t w)
+{
+  Put(w >> 8);
+  Put(w & 0xff);
+}
+
+/**
+ * @brief : CBOR head with the shortest argument
+ */
+void SEN6xEncoder::PutCbor(uint8_t major, uint16_t v)
+{
+  if (v < 24)
+    Put(major << 5 | v);
+  else if (v < 256) {
+    Put(major << 5 | 24);
+    Put(v);
+  }
+  else {
+    Put(major << 5 | 25);
+    PutWord(v);
+  }
+}
+
+/**
+ * @brief : CBOR integer
+ */
+void SEN6xEncoder::PutInt(uint16_t w, bool sign)
+{
+  if (sign && (int16_t) w < 0)
+    PutCbor(CBOR_NEGINT, (uint16_t) (-1 - (int16_t) w));
+  else
+    PutCbor(CBOR_UINT, w);
+}
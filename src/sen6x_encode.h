@@ -0,0 +1,149 @@
+/**
+ * SEN6x Library binary encoder header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xEncoder writes measured values, number concentrations, raw values
+ * and the status in a buffer of the sketch, for an uplink (LoRaWAN, MQTT,
+ * radio) instead of text. No heap is used and only the fields that the
+ * device provides are written. Values are written as integers in the
+ * resolution of the sensor (as in struct sen6x_values_fixed) :
+ *
+ *  PM, VOC, NOX, HCHO, number concentration : x 10
+ *  Hum : x 100, Temp : x 200, CO2 : ppm
+ *
+ * SEN6x_ENC_PACKED : fixed layout, big endian
+ *
+ *  byte 0  : SEN6x_ENC_VERSION << 4 | device (SEN6x_device)
+ *  byte 1  : parts that follow (SEN6x_ENC_xxx)
+ *  values  : 2 bytes for each field the device provides, in the order of
+ *            struct sen6x_values. Unknown is 0xFFFF (0x7FFF for Hum,
+ *            Temp, VOC and NOX).
+ *  conc    : 2 bytes for NumPM0, NumPM1, NumPM2, NumPM4, NumPM10
+ *  raw     : 2 bytes for each field the device provides, in the order of
+ *            struct sen6x_raw_values
+ *  status  : 2 bytes
+ *
+ *  SEN66 values : 20 bytes
+ *
+ * SEN6x_ENC_CBOR : a CBOR (RFC 8949) map
+ *
+ *  {0: header (as byte 0 above), 1: [values], 2: [conc], 3: [raw],
+ *   4: status}
+ *
+ *  The arrays have the same fields as the packed layout, unknown is null.
+ *  SEN66 values : 14 - 32 bytes
+ *
+ * Usage :
+ *
+ *  uint8_t buf[64];
+ *  SEN6xEncoder enc;
+ *
+ *  enc.begin(buf, sizeof(buf), SEN66);            // or SEN6x_ENC_CBOR
+ *  enc.values(&val);
+ *  enc.status(status);
+ *  send(buf, enc.GetLength());
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_ENCODE_H
+#define SEN6x_ENCODE_H
+
+#include "sen6x.h"
+
+#define SEN6x_ENC_VERSION       1
+
+// formats
+#define SEN6x_ENC_PACKED        0
+#define SEN6x_ENC_CBOR          1
+
+// parts (in the order they must be added)
+#define SEN6x_ENC_VALUES        0x01
+#define SEN6x_ENC_CONC          0x02
+#define SEN6x_ENC_RAW           0x04
+#define SEN6x_ENC_STATUS        0x08
+
+class SEN6xEncoder
+{
+  public:
+
+    SEN6xEncoder(void);
+
+    /**
+     * @brief : start a new message
+     *
+     * @param buf    : buffer to write the message
+     * @param size   : bytes in buffer
+     * @param d      : device (see GetDevice())
+     * @param format : SEN6x_ENC_PACKED or SEN6x_ENC_CBOR
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : wrong device or format
+     *  SEN6x_ERR_DATALENGTH : buffer too small
+     */
+    uint8_t begin(uint8_t *buf, uint16_t size, SEN6x_device d, uint8_t format = SEN6x_ENC_PACKED);
+
+    /**
+     * @brief : add a part to the message
+     *
+     * The parts must be added in the order values, conc, raw, status
+     * (each is optional).
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : wrong order, or raw values on a SEN60
+     *  SEN6x_ERR_DATALENGTH : buffer too small (the part is not added)
+     *  SEN6x_ERR_CMDSTATE : begin() was not called
+     */
+    uint8_t values(const struct sen6x_values *v);
+    uint8_t values(const struct sen6x_values_fixed *v);
+    uint8_t conc(const struct sen6x_concentration_values *v);
+    uint8_t conc(const struct sen6x_concentration_fixed *v);
+    uint8_t raw(const struct sen6x_raw_values *v);
+    uint8_t status(uint16_t status);
+
+    /**
+     * @brief : add all parts of a snapshot (see GetSnapshot())
+     *
+     * SEN60 : no raw values
+     */
+    uint8_t snapshot(const struct sen6x_snapshot *s);
+
+    /**
+     * @brief : bytes in the message
+     */
+    uint16_t GetLength(void);
+
+  private:
+    uint8_t *_Buf;
+    uint16_t _Size;
+    uint16_t _Len;
+    uint8_t _Device;
+    uint8_t _Format;
+    uint8_t _Parts;                       // parts added
+    bool _Over;                           // buffer too small
+
+    uint8_t Part(uint8_t part, const void *layout, uint8_t n, const uint16_t *w, bool invalid, uint8_t sign);
+    uint8_t Begin(uint8_t part, uint16_t *start);
+    uint8_t End(uint8_t part, uint16_t start);
+    void Put(uint8_t b);
+    void PutWord(uint16_t w);
+    void PutCbor(uint8_t major, uint16_t v);
+    void PutInt(uint16_t w, bool sign);
+};
+
+#endif /* SEN6x_ENCODE_H */
@@ -0,0 +1,363 @@
+/**
+ * SEN6x Library sample history file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Keeps measured values as received from the sensor in a ring buffer
+ * (see sen6x_history.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_history.h"
+#include "Sen6xLayouts.h"
+
+/**
+ * @brief : store a value as varint (7 bits per byte, bit 7 : more follow)
+ *
+ * @return number of bytes
+ */
+static uint8_t PutVarint(uint8_t *p, uint32_t v)
+{
+  uint8_t n = 0;
+
+  while (v > 0x7F) {
+    p[n++] = (uint8_t) (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+
+  p[n++] = (uint8_t) v;
+
+  return(n);
+}
+
+SEN6xHistory::SEN6xHistory(void)
+{
+  _Buf = NULL;
+  _Size = 0;
+  _Device = SEN66;
+  _Words = 0;
+  _Delta = true;
+  clear();
+}
+
+/**
+ * @brief : start (an empty) history
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PARAMETER : wrong device or buffer too small
+ */
+uint8_t SEN6xHistory::begin(SEN6x_device d, uint8_t *buf, uint16_t size, bool delta)
+{
+  uint8_t i, w;
+
+  if (d > SEN68 || buf == NULL || size < SEN6x_HIST_RECORD) return(SEN6x_ERR_PARAMETER);
+
+  _Buf = buf;
+  _Size = size;
+  _Device = d;
+  _Delta = delta;
+
+  // words in the measured values of this sensor
+  _Words = 0;
+
+  for (i = 0; i < SEN6x_VALUES_FIELDS; i++) {
+    w = SEN6x_READ_BYTE(&SEN6xValuesLayout[d][i].word);
+    if (w != SEN6x_L_NONE && w + 1 > _Words) _Words = w + 1;
+  }
+
+  clear();
+
+  return(SEN6x_ERR_OK);
+}
+
+void SEN6xHistory::clear(void)
+{
+  _Tail = _Used = _Count = 0;
+  _CurIdx = 0;
+  memset(_Last, 0x0, sizeof(_Last));
+}
+
+uint8_t SEN6xHistory::add(const struct sen6x_values_fixed *v)
+{
+  return(add(v, millis()));
+}
+
+/**
+ * @brief : add a sample, the oldest samples are removed if needed
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : begin() was not called
+ */
+uint8_t SEN6xHistory::add(const struct sen6x_values_fixed *v, unsigned long t)
+{
+  uint16_t words[SEN6x_HIST_WORDS];
+  uint8_t rec[SEN6x_HIST_RECORD];
+  uint32_t dt = 0;
+  uint8_t i, w, len;
+  int16_t d;
+
+  if (_Buf == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  // back to the words as received
+  memset(words, 0x0, sizeof(words));
+
+  for (i = 0; i < SEN6x_VALUES_FIELDS; i++) {
+    w = SEN6x_READ_BYTE(&SEN6xValuesLayout[_Device][i].word);
+    if (w != SEN6x_L_NONE) memcpy(&words[w], (const uint8_t *) v + i * sizeof(uint16_t), sizeof(uint16_t));
+  }
+
+  if (_Count > 0) dt = (t - _LastTime + SEN6x_HIST_TICK / 2) / SEN6x_HIST_TICK;
+
+  len = PutVarint(rec, dt);
+
+  for (i = 0; i < _Words; i++) {
+
+    if (_Delta) {
+      // zigzag : small positive and negative differences in 1 byte
+      d = (int16_t) (words[i] - _Last[i]);
+      len += PutVarint(&rec[len], (uint16_t) (((int) d << 1) ^ ((int) d >> 15)));
+    }
+    else {
+      rec[len++] = words[i] >> 8;
+      rec[len++] = words[i] & 0xff;
+    }
+  }
+
+  while (_Size - _Used < len) Drop();
+
+  for (i = 0; i < len; i++) _Buf[((uint32_t) _Tail + _Used + i) % _Size] = rec[i];
+
+  _Used += len;
+
+  if (_Count == 0) {
+    memcpy(_First, words, sizeof(words));
+    _FirstTime = _LastTime = t;
+  }
+  else
+    _LastTime += dt * SEN6x_HIST_TICK;
+
+  memcpy(_Last, words, sizeof(words));
+  _Count++;
+
+  return(SEN6x_ERR_OK);
+}
+
+uint16_t SEN6xHistory::GetCount(void)
+{
+  return(_Count);
+}
+
+uint16_t SEN6xHistory::GetUsed(void)
+{
+  return(_Used);
+}
+
+/**
+ * @brief : read sample i (0 = oldest)
+ */
+bool SEN6xHistory::Get(uint16_t i, struct sen6x_values *v, unsigned long *t)
+{
+  uint16_t words[SEN6x_HIST_WORDS];
+  uint8_t f[SEN6x_HIST_WORDS * 3];
+
+  if (i >= _Count) return(false);
+
+  Seek(i, words, t);
+  Frame(words, f);
+  SEN6x_DecodeFrame(f, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, v);
+
+  return(true);
+}
+
+bool SEN6xHistory::Get(uint16_t i, struct sen6x_values_fixed *v, unsigned long *t)
+{
+  uint16_t words[SEN6x_HIST_WORDS];
+  uint8_t f[SEN6x_HIST_WORDS * 3];
+
+  if (i >= _Count) return(false);
+
+  Seek(i, words, t);
+  Frame(words, f);
+  SEN6x_DecodeFixed(f, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, v);
+
+  return(true);
+}
+
+/**
+ * @brief : read the samples from oldest to newest
+ */
+void SEN6xHistory::Rewind(void)
+{
+  _CurIdx = 0;
+}
+
+bool SEN6xHistory::Next(struct sen6x_values *v, unsigned long *t)
+{
+  uint8_t f[SEN6x_HIST_WORDS * 3];
+
+  if (! Read()) return(false);
+
+  Frame(_Cur, f);
+  SEN6x_DecodeFrame(f, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, v);
+  *t = _CurTime;
+
+  return(true);
+}
+
+bool SEN6xHistory::Next(struct sen6x_values_fixed *v, unsigned long *t)
+{
+  uint8_t f[SEN6x_HIST_WORDS * 3];
+
+  if (! Read()) return(false);
+
+  Frame(_Cur, f);
+  SEN6x_DecodeFixed(f, SEN6xValuesLayout[_Device], SEN6x_VALUES_FIELDS, v);
+  *t = _CurTime;
+
+  return(true);
+}
+
+/**
+ * @brief : decode the next sample for Next() in _Cur
+ *
+ * @return
+ *  true  : ok
+ *  false : no more samples
+ */
+bool SEN6xHistory::Read(void)
+{
+  if (_CurIdx >= _Count) return(false);
+
+  if (_CurIdx == 0)
+    _CurPos = Seek(0, _Cur, &_CurTime);
+  else
+    _CurPos = ((uint32_t) _CurPos + Parse(_CurPos, _Cur, &_CurTime)) % _Size;
+
+  _CurIdx++;
+
+  return(true);
+}
+
+/**
+ * @brief : decode sample i
+ *
+ * The oldest sample is kept decoded in _First. The stored bytes of the
+ * oldest sample are skipped, each next sample is applied on the previous.
+ *
+ * @return first byte of sample i + 1
+ */
+uint16_t SEN6xHistory::Seek(uint16_t i, uint16_t *words, unsigned long *t)
+{
+  uint16_t pos, k;
+
+  memcpy(words, _First, sizeof(_First));
+  *t = _FirstTime;
+
+  pos = ((uint32_t) _Tail + Parse(_Tail, NULL, NULL)) % _Size;
+
+  for (k = 0; k < i; k++)
+    pos = ((uint32_t) pos + Parse(pos, words, t)) % _Size;
+
+  return(pos);
+}
+
+/**
+ * @brief : remove the oldest sample
+ *
+ * The next sample becomes the oldest and is applied on _First.
+ */
+void SEN6xHistory::Drop(void)
+{
+  uint16_t n = Parse(_Tail, NULL, NULL);
+
+  _Tail = ((uint32_t) _Tail + n) % _Size;
+  _Used -= n;
+  _Count--;
+
+  if (_Count > 0) Parse(_Tail, _First, &_FirstTime);
+}
+
+/**
+ * @brief : decode a stored sample
+ *
+ * @param pos   : first byte of the sample
+ * @param words : previous sample, updated with this sample (NULL : skip)
+ * @param t     : time of previous sample, updated (NULL : skip)
+ *
+ * @return number of bytes of the sample
+ */
+uint16_t SEN6xHistory::Parse(uint16_t pos, uint16_t *words, unsigned long *t)
+{
+  uint16_t n = 0;
+  uint32_t v;
+  uint8_t i;
+
+  v = Varint(pos, &n);
+  if (t) *t += v * SEN6x_HIST_TICK;
+
+  for (i = 0; i < _Words; i++) {
+
+    if (_Delta) {
+      v = Varint(pos, &n);
+      if (words) words[i] += (uint16_t) ((v >> 1) ^ (0 - (v & 1)));
+    }
+    else {
+      v = (uint16_t) _Buf[((uint32_t) pos + n) % _Size] << 8;
+      v |= _Buf[((uint32_t) pos + n + 1) % _Size];
+      n += 2;
+      if (words) words[i] = (uint16_t) v;
+    }
+  }
+
+  return(n);
+}
+
+/**
+ * @brief : read a varint
+ *
+ * @param pos : first byte of the sample
+ * @param n   : offset in the sample, updated
+ */
+uint32_t SEN6xHistory::Varint(uint16_t pos, uint16_t *n)
+{
+  uint32_t v = 0;
+  uint8_t b, shift = 0;
+
+  do {
+    b = _Buf[((uint32_t) pos + (*n)++) % _Size];
+    v |= (uint32_t) (b & 0x7F) << shift;
+    shift += 7;
+  } while (b & 0x80);
+
+  return(v);
+}
+
+/**
+ * @brief : create a frame as received from the words (CRC not set)
+ */
+void SEN6xHistory::Frame(const uint16_t *words, uint8_t *f)
+{
+  uint8_t i;
+
+  for (i = 0; i < _Words; i++) {
+    f[i * 3] = words[i] >> 8;
+    f[i * 3 + 1] = words[i] & 0xff;
+  }
+}
@@ -0,0 +1,166 @@
+/**
+ * SEN6x Library sample history header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xHistory keeps the measured values of the last samples in a ring
+ * buffer provided by the sketch. A struct sen6x_values takes 60 bytes,
+ * while the sensor only sends 9 words (SEN66). The history stores the
+ * words as received, and decodes them when a sample is read.
+ *
+ * Each sample is stored as :
+ *  - the time since the previous sample in SEN6x_HIST_TICK mS (varint)
+ *  - delta : per word the difference with the previous sample (zigzag
+ *            varint). Values change slowly, most words take 1 byte.
+ *    else  : per word the 2 bytes as received
+ *
+ * A SEN66 sample at 1 second interval takes about 10 bytes with delta
+ * (about 19 without). Once the buffer is full the oldest samples are
+ * removed.
+ *
+ * Usage :
+ *
+ *  uint8_t buf[8192];                 // about 800 samples / 13 minutes
+ *  SEN6xHistory history;
+ *
+ *  setup() :
+ *  history.begin(SEN66, buf, sizeof(buf));
+ *
+ *  loop() :
+ *  if (sen6x.GetValuesFixed(&fix) == SEN6x_ERR_OK) history.add(&fix);
+ *
+ *  reading :
+ *  history.Rewind();
+ *  while (history.Next(&val, &t)) { .. }
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_HISTORY_H
+#define SEN6x_HISTORY_H
+
+#include "sen6x.h"
+
+// resolution of the time stamps
+#define SEN6x_HIST_TICK         100       // mS
+
+#define SEN6x_HIST_WORDS        9         // words in measured values
+
+// maximum bytes of a sample : time (5) + 3 per word
+#define SEN6x_HIST_RECORD       (5 + SEN6x_HIST_WORDS * 3)
+
+class SEN6xHistory
+{
+  public:
+
+    SEN6xHistory(void);
+
+    /**
+     * @brief : start (an empty) history
+     *
+     * @param d     : SEN60, SEN63C, SEN65, SEN66 or SEN68
+     * @param buf   : buffer to store the samples
+     * @param size  : bytes in buffer (at least SEN6x_HIST_RECORD)
+     * @param delta : store the difference with the previous sample
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : wrong device or buffer too small
+     */
+    uint8_t begin(SEN6x_device d, uint8_t *buf, uint16_t size, bool delta = true);
+
+    /**
+     * @brief : remove all samples
+     */
+    void clear(void);
+
+    /**
+     * @brief : add a sample (see GetValuesFixed() in sen6x.h)
+     *
+     * @param v : measured values
+     * @param t : time of the sample in mS (default millis())
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_CMDSTATE : begin() was not called
+     */
+    uint8_t add(const struct sen6x_values_fixed *v);
+    uint8_t add(const struct sen6x_values_fixed *v, unsigned long t);
+
+    /**
+     * @brief : number of samples / bytes used in the buffer
+     */
+    uint16_t GetCount(void);
+    uint16_t GetUsed(void);
+
+    /**
+     * @brief : read sample i (0 = oldest)
+     *
+     * The samples before i have to be decoded first. Use Rewind() and
+     * Next() to read all samples.
+     *
+     * @param v : to store the values
+     * @param t : time of the sample in mS (resolution SEN6x_HIST_TICK)
+     *
+     * @return
+     *  true  : ok
+     *  false : no sample i
+     */
+    bool Get(uint16_t i, struct sen6x_values *v, unsigned long *t);
+    bool Get(uint16_t i, struct sen6x_values_fixed *v, unsigned long *t);
+
+    /**
+     * @brief : read the samples from oldest to newest
+     *
+     * Rewind() starts at the oldest sample. Next() returns the next
+     * sample. Do not call add() while reading.
+     *
+     * @return (Next)
+     *  true  : ok
+     *  false : no more samples
+     */
+    void Rewind(void);
+    bool Next(struct sen6x_values *v, unsigned long *t);
+    bool Next(struct sen6x_values_fixed *v, unsigned long *t);
+
+  private:
+    uint8_t *_Buf;
+    uint16_t _Size;                       // bytes in _Buf
+    uint16_t _Tail;                       // first byte of oldest sample
+    uint16_t _Used;                       // bytes used
+    uint16_t _Count;                      // samples
+    uint8_t _Device;
+    uint8_t _Words;                       // words per sample
+    bool _Delta;
+
+    uint16_t _First[SEN6x_HIST_WORDS];    // oldest sample
+    unsigned long _FirstTime;
+    uint16_t _Last[SEN6x_HIST_WORDS];     // newest sample
+    unsigned long _LastTime;
+
+    uint16_t _Cur[SEN6x_HIST_WORDS];      // last sample of Next()
+    unsigned long _CurTime;
+    uint16_t _CurPos;                     // first byte of next sample
+    uint16_t _CurIdx;                     // index of next sample
+
+    uint16_t Parse(uint16_t pos, uint16_t *words, unsigned long *t);
+    uint32_t Varint(uint16_t pos, uint16_t *n);
+    uint16_t Seek(uint16_t i, uint16_t *words, unsigned long *t);
+    bool Read(void);
+    void Drop(void);
+    void Frame(const uint16_t *words, uint8_t *f);
+};
+
+#endif /* SEN6x_HISTORY_H */
@@ -0,0 +1,86 @@
+/**
+ * SEN6x Library host support file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Provides the few Arduino routines the library needs, so the library
+ * can be build on a host (e.g. Linux) without the Arduino core.
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#if not defined ARDUINO
+
+#include "sen6x_host.h"
+#include <time.h>
+
+SEN6xHostDebug SEN6xHostSerial;
+
+/**
+ * @brief : milliseconds since first call (monotonic)
+ */
+unsigned long millis(void)
+{
+  static struct timespec start;
+  static bool init = false;
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (! init) {
+    start = now;
+    init = true;
+  }
+
+  return((unsigned long) ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000));
+}
+
+/**
+ * @brief : wait for ms milliseconds
+ */
+void delay(unsigned long ms)
+{
+  struct timespec ts;
+
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000;
+
+  nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief : give up the CPU
+ *
+ * Called while waiting for a command to execute on the device.
+ * A short sleep prevents a busy loop on the host.
+ */
+void yield(void)
+{
+  struct timespec ts = {0, 100000};     // 100uS
+
+  nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief : debug output to stderr
+ */
+void SEN6xHostDebug::print(const char *s)
+{
+  fputs(s, stderr);
+}
+
+#endif // ARDUINO
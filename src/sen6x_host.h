@@ -0,0 +1,65 @@
+/**
+ * SEN6x Library host support header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Provides the few Arduino routines the library needs, so the library
+ * can be build on a host (e.g. Linux) without the Arduino core.
+ * Used automatically by sen6x.h when ARDUINO is not defined.
+ *
+ * Debug messages are written to stderr.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_HOST_H
+#define SEN6x_HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef uint8_t byte;
+
+/**
+ * @brief : milliseconds since first call (monotonic)
+ */
+unsigned long millis(void);
+
+/**
+ * @brief : wait for ms milliseconds
+ */
+void delay(unsigned long ms);
+
+/**
+ * @brief : give up the CPU
+ */
+void yield(void);
+
+/**
+ * debug output (replaces Serial)
+ */
+class SEN6xHostDebug
+{
+  public:
+    void print(const char *s);
+};
+
+extern SEN6xHostDebug SEN6xHostSerial;
+
+#endif /* SEN6x_HOST_H */
@@ -0,0 +1,289 @@
+/**
+ * SEN6x Library Linux i2c-dev transport file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Transport to connect the SEN6x on a Linux host with /dev/i2c-N.
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_linux.h"
+
+#if defined(__linux__) && not defined(ARDUINO)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+SEN6xLinuxI2C::SEN6xLinuxI2C(void)
+{
+  _fd = -1;
+  _slave = -1;
+  _mode = SEN6x_LINUX_RDWR;
+}
+
+SEN6xLinuxI2C::~SEN6xLinuxI2C(void)
+{
+  end();
+}
+
+/**
+ * @brief : open the i2c-dev device and determine how to transfer
+ *
+ * @param device : e.g. "/dev/i2c-1"
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : could not open device or get functionality
+ */
+uint8_t SEN6xLinuxI2C::begin(const char *device)
+{
+  unsigned long funcs;
+
+  end();
+
+  _fd = open(device, O_RDWR);
+
+  if (_fd < 0) return(SEN6x_ERR_CMDSTATE);
+
+  if (ioctl(_fd, I2C_FUNCS, &funcs) < 0) {
+    end();
+    return(SEN6x_ERR_CMDSTATE);
+  }
+
+  if (funcs & I2C_FUNC_I2C) _mode = SEN6x_LINUX_RDWR;
+  else if (funcs & I2C_FUNC_SMBUS_I2C_BLOCK) _mode = SEN6x_LINUX_SMBUS;
+  else _mode = SEN6x_LINUX_RW;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : close the i2c-dev device
+ */
+void SEN6xLinuxI2C::end(void)
+{
+  if (_fd >= 0) close(_fd);
+
+  _fd = -1;
+  _slave = -1;
+}
+
+SEN6x_linux_mode SEN6xLinuxI2C::GetMode(void)
+{
+  return(_mode);
+}
+
+/**
+ * @brief : write frame
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PROTOCOL : no acknowledge or other bus error
+ */
+uint8_t SEN6xLinuxI2C::write(uint8_t addr, const uint8_t *buf, uint8_t len)
+{
+  struct i2c_msg msg;
+
+  msg.addr = addr;
+  msg.flags = 0;
+  msg.len = len;
+  msg.buf = (uint8_t *) buf;
+
+  if (Transfer(&msg, 1) != 0) return(SEN6x_ERR_PROTOCOL);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : read frame in one transfer
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PROTOCOL : could not read frame
+ */
+uint8_t SEN6xLinuxI2C::read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got)
+{
+  struct i2c_msg msg;
+
+  *got = 0;
+
+  msg.addr = addr;
+  msg.flags = I2C_M_RD;
+  msg.len = len;
+  msg.buf = buf;
+
+  if (Transfer(&msg, 1) != 0) return(SEN6x_ERR_PROTOCOL);
+
+  *got = len;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : write a frame and read the answer with a repeated start
+ * in one system call.
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PROTOCOL : bus error
+ */
+uint8_t SEN6xLinuxI2C::writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen,
+                                 uint8_t *rbuf, uint8_t rlen, uint8_t *got)
+{
+  struct i2c_msg msgs[2];
+
+  *got = 0;
+
+  msgs[0].addr = addr;
+  msgs[0].flags = 0;
+  msgs[0].len = wlen;
+  msgs[0].buf = (uint8_t *) wbuf;
+
+  msgs[1].addr = addr;
+  msgs[1].flags = I2C_M_RD;
+  msgs[1].len = rlen;
+  msgs[1].buf = rbuf;
+
+  if (Transfer(msgs, 2) != 0) return(SEN6x_ERR_PROTOCOL);
+
+  *got = rlen;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : perform the I2C messages on the bus
+ *
+ * @return
+ *  0 : ok
+ *  else error
+ */
+int SEN6xLinuxI2C::Transfer(struct i2c_msg *msgs, int nmsgs)
+{
+  struct i2c_rdwr_ioctl_data data;
+  int i;
+
+  if (_fd < 0) return(-1);
+
+  if (_mode == SEN6x_LINUX_RDWR) {
+    data.msgs = msgs;
+    data.nmsgs = nmsgs;
+
+    if (ioctl(_fd, I2C_RDWR, &data) != nmsgs) return(-1);
+
+    return(0);
+  }
+
+  // one message at a time (no repeated start)
+  for (i = 0; i < nmsgs; i++) {
+
+    if (_mode == SEN6x_LINUX_SMBUS) {
+      if (TransferSMBus(&msgs[i]) != 0) return(-1);
+    }
+    else {
+      if (TransferRW(&msgs[i]) != 0) return(-1);
+    }
+  }
+
+  return(0);
+}
+
+/**
+ * @brief : set the address for read() and write()
+ */
+int SEN6xLinuxI2C::SetSlave(uint8_t addr)
+{
+  if (_slave == addr) return(0);
+
+  if (ioctl(_fd, I2C_SLAVE, addr) < 0) return(-1);
+
+  _slave = addr;
+
+  return(0);
+}
+
+/**
+ * @brief : transfer message with I2C_SLAVE and read() / write()
+ */
+int SEN6xLinuxI2C::TransferRW(struct i2c_msg *msg)
+{
+  if (SetSlave(msg->addr) != 0) return(-1);
+
+  if (msg->flags & I2C_M_RD) {
+    if (::read(_fd, msg->buf, msg->len) != msg->len) return(-1);
+  }
+  else {
+    if (::write(_fd, msg->buf, msg->len) != msg->len) return(-1);
+  }
+
+  return(0);
+}
+
+/**
+ * @brief : transfer message with SMBus commands (i2c-stub)
+ *
+ * write : I2C block write, first byte of frame is the SMBus command
+ * read  : receive byte for each byte of the frame
+ */
+int SEN6xLinuxI2C::TransferSMBus(struct i2c_msg *msg)
+{
+  struct i2c_smbus_ioctl_data args;
+  union i2c_smbus_data data;
+  uint16_t i;
+
+  if (SetSlave(msg->addr) != 0) return(-1);
+
+  args.data = &data;
+
+  if (msg->flags & I2C_M_RD) {
+
+    args.read_write = I2C_SMBUS_READ;
+    args.command = 0;
+    args.size = I2C_SMBUS_BYTE;
+
+    for (i = 0; i < msg->len; i++) {
+      if (ioctl(_fd, I2C_SMBUS, &args) < 0) return(-1);
+      msg->buf[i] = data.byte;
+    }
+
+    return(0);
+  }
+
+  if (msg->len == 0 || msg->len - 1 > I2C_SMBUS_BLOCK_MAX) return(-1);
+
+  args.read_write = I2C_SMBUS_WRITE;
+  args.command = msg->buf[0];
+
+  if (msg->len == 1) {
+    args.size = I2C_SMBUS_BYTE;
+    args.data = NULL;
+  }
+  else {
+    args.size = I2C_SMBUS_I2C_BLOCK_DATA;
+    data.block[0] = msg->len - 1;
+    for (i = 1; i < msg->len; i++) data.block[i] = msg->buf[i];
+  }
+
+  if (ioctl(_fd, I2C_SMBUS, &args) < 0) return(-1);
+
+  return(0);
+}
+
+#endif // __linux__
@@ -0,0 +1,119 @@
+/**
+ * SEN6x Library Linux i2c-dev transport header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Transport to connect the SEN6x on a Linux host (e.g. a gateway or
+ * Raspberry Pi) with /dev/i2c-N. The library is build without the
+ * Arduino core (see sen6x_host.h).
+ *
+ * Each frame is transferred in one system call with ioctl(I2C_RDWR).
+ * If the adapter does not support I2C_RDWR, I2C_SLAVE with read() and
+ * write() is used.
+ *
+ * An adapter that only supports SMBus (like the i2c-stub kernel module)
+ * is handled with SMBus I2C-block writes and receive-byte reads. That
+ * allows to test the plumbing without a sensor, but will NOT work with
+ * a real SEN6x.
+ *
+ * For a user-space stand-in (no kernel module), derive from
+ * SEN6xLinuxI2C and overrule Transfer().
+ *
+ * Usage :
+ *
+ *  SEN6xLinuxI2C bus;
+ *  SEN6x sen6x;
+ *
+ *  if (bus.begin("/dev/i2c-1") != SEN6x_ERR_OK) exit(1);
+ *  if (! sen6x.begin(&bus)) sen6x.SetDevice(SEN66);
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_LINUX_H
+#define SEN6x_LINUX_H
+
+#if defined(__linux__) && not defined(ARDUINO)
+
+#include "sen6x.h"
+#include <linux/i2c.h>
+
+/**
+ * How frames are transferred
+ */
+enum SEN6x_linux_mode {
+  SEN6x_LINUX_RDWR = 0,       // ioctl(I2C_RDWR), combined transfers
+  SEN6x_LINUX_RW,             // ioctl(I2C_SLAVE) + read() / write()
+  SEN6x_LINUX_SMBUS           // SMBus only (i2c-stub), NOT for a real SEN6x
+};
+
+class SEN6xLinuxI2C : public SEN6xTransport
+{
+  public:
+
+    SEN6xLinuxI2C(void);
+    ~SEN6xLinuxI2C(void);
+
+    /**
+     * @brief : open the i2c-dev device
+     *
+     * @param device : e.g. "/dev/i2c-1"
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_CMDSTATE : could not open device or get functionality
+     */
+    uint8_t begin(const char *device);
+
+    /**
+     * @brief : close the i2c-dev device
+     */
+    void end(void);
+
+    /**
+     * @brief : obtain how frames are transferred
+     */
+    SEN6x_linux_mode GetMode(void);
+
+    uint8_t write(uint8_t addr, const uint8_t *buf, uint8_t len);
+    uint8_t read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got);
+    uint8_t writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen,
+                      uint8_t *rbuf, uint8_t rlen, uint8_t *got);
+
+  protected:
+
+    /**
+     * @brief : perform the I2C messages on the bus
+     *
+     * Overrule for a user-space stand-in.
+     *
+     * @return
+     *  0 : ok
+     *  else error
+     */
+    virtual int Transfer(struct i2c_msg *msgs, int nmsgs);
+
+  private:
+    int _fd;                    // file descriptor of i2c-dev
+    int _slave;                 // address set with I2C_SLAVE (-1 = none)
+    SEN6x_linux_mode _mode;
+
+    int SetSlave(uint8_t addr);
+    int TransferRW(struct i2c_msg *msg);
+    int TransferSMBus(struct i2c_msg *msg);
+};
+
+#endif // __linux__
+#endif /* SEN6x_LINUX_H */
@@ -0,0 +1,415 @@
+/**
+ * SEN6x Library multi-sensor manager file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Reads many SEN6x sensors behind TCA9548A multiplexers (see sen6x_multi.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_multi.h"
+#include "Sen6xCommands.h"
+#include "Sen6xLayouts.h"
+
+// state of a sensor
+#define SEN6x_UNIT_IDLE       0
+#define SEN6x_UNIT_PENDING    1         // command send, executing
+
+#define SEN6x_MUX_UNKNOWN     0xFF      // state of multiplexers unknown
+
+SEN6xMulti::SEN6xMulti(void)
+{
+  _bus = NULL;
+  _Count = 0;
+  _Mux = SEN6x_MUX_UNKNOWN;
+  _Channel = 0;
+  _Next = _Done = 0;
+  _Sweep = false;
+}
+
+#if not defined SEN6x_HOST
+/**
+ * @brief : begin with the I2C port to use
+ */
+void SEN6xMulti::begin(TwoWire *wirePort)
+{
+  _TwoWire.SetPort(wirePort);
+  begin(&_TwoWire);
+}
+#endif // SEN6x_HOST
+
+/**
+ * @brief : begin with a transport
+ */
+void SEN6xMulti::begin(SEN6xTransport *transport)
+{
+  _bus = transport;
+  _Mux = SEN6x_MUX_UNKNOWN;
+}
+
+/**
+ * @brief : add a sensor
+ *
+ * @return
+ *  id of the sensor
+ *  -1 : too many sensors or wrong parameter
+ */
+int8_t SEN6xMulti::add(SEN6x_device d, uint8_t mux, uint8_t channel)
+{
+  struct sen6x_multi_unit *u;
+
+  if (_Count >= SEN6x_MULTI_MAX || _Sweep) return(-1);
+
+  if (d > SEN68 || channel > 7) return(-1);
+
+  if (mux != SEN6x_NO_MUX && (mux < TCA9548A_I2CAddress || mux > TCA9548A_I2CAddress + 7)) return(-1);
+
+  u = &_Units[_Count];
+  memset(u, 0x0, sizeof(struct sen6x_multi_unit));
+  u->device = d;
+  u->mux = mux;
+  u->channel = channel;
+  u->state = SEN6x_UNIT_IDLE;
+  u->result = SEN6x_ERR_CMDSTATE;     // not read yet
+
+  return(_Count++);
+}
+
+uint8_t SEN6xMulti::GetCount(void)
+{
+  return(_Count);
+}
+
+/**
+ * @brief : start / stop measurement on all sensors
+ */
+uint8_t SEN6xMulti::start(void)
+{
+  return(Broadcast(SEN6x_START_MEASUREMENT));
+}
+
+uint8_t SEN6xMulti::stop(void)
+{
+  return(Broadcast(SEN6x_STOP_MEASUREMENT));
+}
+
+/**
+ * @brief : send the command to all sensors and wait once for
+ * all of them to execute.
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok on all sensors
+ *  else error of the first sensor that failed
+ */
+uint8_t SEN6xMulti::Broadcast(Sen6x_Comds_offset cmd)
+{
+  uint8_t i, ret = SEN6x_ERR_OK;
+
+  if (_Sweep) return(SEN6x_ERR_CMDSTATE);
+
+  for (i = 0; i < _Count; i++) _Units[i].result = Send(i, cmd);
+
+  // the sensors execute in parallel
+  for (i = 0; i < _Count; i++) {
+
+    if (_Units[i].state == SEN6x_UNIT_PENDING) {
+      while (! Elapsed(i)) yield();
+      _Units[i].state = SEN6x_UNIT_IDLE;
+    }
+
+    if (_Units[i].result != SEN6x_ERR_OK && ret == SEN6x_ERR_OK) ret = _Units[i].result;
+  }
+
+  return(ret);
+}
+
+/**
+ * @brief : start a sweep over all sensors
+ */
+uint8_t SEN6xMulti::sweep(void)
+{
+  if (_Sweep) return(SEN6x_ERR_CMDSTATE);
+
+  if (_bus == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  _Next = _Done = 0;
+  _Sweep = true;
+
+  poll();
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : move the sweep forward
+ *
+ * The command is send to all sensors, one after the other. In between
+ * the sensors of which the execution time has passed are read, in the
+ * order the command was send.
+ *
+ * @return
+ *  true  : sweep is complete (or none pending)
+ *  false : sweep still pending
+ */
+bool SEN6xMulti::poll(void)
+{
+  if (! _Sweep) return(true);
+
+  while (1) {
+
+    // read the sensors that have executed
+    while (_Done < _Next) {
+
+      if (_Units[_Done].state == SEN6x_UNIT_PENDING) {
+        if (! Elapsed(_Done)) break;
+        Read(_Done);
+      }
+
+      _Done++;
+    }
+
+    if (_Next >= _Count) break;
+
+    // next sensor can execute while the others are read
+    _Units[_Next].result = Send(_Next, SEN6x_READ_MEASURED_VALUE);
+    _Next++;
+  }
+
+  if (_Done < _Count) return(false);
+
+  _Sweep = false;
+
+  return(true);
+}
+
+/**
+ * @brief : perform a sweep and wait for it to complete
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok on all sensors
+ *  else error of the first sensor that failed
+ */
+uint8_t SEN6xMulti::update(void)
+{
+  uint8_t i, ret;
+
+  ret = sweep();
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  while (! poll()) yield();
+
+  for (i = 0; i < _Count; i++) {
+    if (_Units[i].result != SEN6x_ERR_OK) return(_Units[i].result);
+  }
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : obtain the result of the last read
+ */
+uint8_t SEN6xMulti::GetResult(uint8_t id)
+{
+  if (id >= _Count) return(SEN6x_ERR_PARAMETER);
+
+  return(_Units[id].result);
+}
+
+/**
+ * @brief : obtain the measured values of the last sweep
+ *
+ * The words are placed back in the shared frame buffer, to decode them
+ * with the layout of the sensor.
+ */
+uint8_t SEN6xMulti::GetValues(uint8_t id, struct sen6x_values *v)
+{
+  uint8_t i;
+
+  if (id >= _Count || _Units[id].result != SEN6x_ERR_OK) {
+    memset(v, 0x0, sizeof(struct sen6x_values));
+    return(id >= _Count ? SEN6x_ERR_PARAMETER : _Units[id].result);
+  }
+
+  for (i = 0; i < SEN6x_MULTI_WORDS; i++) {
+    _Frame[i * 3] = _Units[id].words[i] >> 8;
+    _Frame[i * 3 + 1] = _Units[id].words[i] & 0xff;
+  }
+
+  SEN6x_DecodeFrame(_Frame, SEN6xValuesLayout[_Units[id].device], SEN6x_VALUES_FIELDS, v);
+
+  return(SEN6x_ERR_OK);
+}
+
+uint8_t SEN6xMulti::GetValuesFixed(uint8_t id, struct sen6x_values_fixed *v)
+{
+  uint8_t i;
+
+  if (id >= _Count || _Units[id].result != SEN6x_ERR_OK) {
+    memset(v, 0x0, sizeof(struct sen6x_values_fixed));
+    return(id >= _Count ? SEN6x_ERR_PARAMETER : _Units[id].result);
+  }
+
+  for (i = 0; i < SEN6x_MULTI_WORDS; i++) {
+    _Frame[i * 3] = _Units[id].words[i] >> 8;
+    _Frame[i * 3 + 1] = _Units[id].words[i] & 0xff;
+  }
+
+  SEN6x_DecodeFixed(_Frame, SEN6xValuesLayout[_Units[id].device], SEN6x_VALUES_FIELDS, v);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : select the channel of a sensor
+ *
+ * Only one channel on one multiplexer is enabled at a time, as all
+ * sensors (except SEN60) have the same address.
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  else error
+ */
+uint8_t SEN6xMulti::Select(uint8_t id)
+{
+  struct sen6x_multi_unit *u;
+  uint8_t b = 0, i;
+
+  if (id >= _Count || _bus == NULL) return(SEN6x_ERR_PARAMETER);
+
+  u = &_Units[id];
+
+  if (u->mux == _Mux && (u->mux == SEN6x_NO_MUX || u->channel == _Channel))
+    return(SEN6x_ERR_OK);
+
+  // disable all multiplexers
+  if (_Mux == SEN6x_MUX_UNKNOWN) {
+    for (i = 0; i < _Count; i++) {
+      if (_Units[i].mux != SEN6x_NO_MUX) _bus->write(_Units[i].mux, &b, 1);
+    }
+  }
+  // disable the active multiplexer
+  else if (_Mux != SEN6x_NO_MUX && _Mux != u->mux) {
+    _bus->write(_Mux, &b, 1);
+  }
+
+  _Mux = SEN6x_MUX_UNKNOWN;
+
+  if (u->mux != SEN6x_NO_MUX) {
+    b = 1 << u->channel;
+    if (_bus->write(u->mux, &b, 1) != SEN6x_ERR_OK) return(SEN6x_ERR_PROTOCOL);
+  }
+
+  _Mux = u->mux;
+  _Channel = u->channel;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : send a command (without parameters) to a sensor
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok, sensor is executing
+ *  else error
+ */
+uint8_t SEN6xMulti::Send(uint8_t id, Sen6x_Comds_offset cmd)
+{
+  struct sen6x_multi_unit *u = &_Units[id];
+  uint16_t opcode = SEN6x_OPCODE(u->device, cmd);
+  uint8_t buf[2], ret;
+
+  u->state = SEN6x_UNIT_IDLE;
+
+  if (opcode == 0x0000) return(SEN6x_ERR_UNKNOWNCMD);
+
+  ret = Select(id);
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  buf[0] = opcode >> 8;
+  buf[1] = opcode & 0xff;
+
+  if (_bus->write(Address(id), buf, 2) != SEN6x_ERR_OK) return(SEN6x_ERR_PROTOCOL);
+
+  u->start = (uint16_t) millis();
+  u->cmd = cmd;
+  u->state = SEN6x_UNIT_PENDING;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : read the measured values of a sensor in the shared frame
+ * buffer and keep the words.
+ */
+void SEN6xMulti::Read(uint8_t id)
+{
+  struct sen6x_multi_unit *u = &_Units[id];
+  uint8_t i, cnt, got;
+
+  u->state = SEN6x_UNIT_IDLE;
+
+  u->result = Select(id);
+  if (u->result != SEN6x_ERR_OK) return;
+
+  cnt = Words(id) * 3;
+
+  _bus->read(Address(id), _Frame, cnt, &got);
+
+  if (got != cnt || SEN6x_CheckFrame(_Frame, cnt) != cnt / 3) {
+    u->result = SEN6x_ERR_PROTOCOL;
+    return;
+  }
+
+  for (i = 0; i < SEN6x_MULTI_WORDS; i++)
+    u->words[i] = (i < cnt / 3) ? (uint16_t) _Frame[i * 3] << 8 | _Frame[i * 3 + 1] : 0;
+
+  u->result = SEN6x_ERR_OK;
+}
+
+/**
+ * @brief : check the execution time of the command send has passed
+ */
+bool SEN6xMulti::Elapsed(uint8_t id)
+{
+  struct sen6x_multi_unit *u = &_Units[id];
+
+  return((uint16_t)((uint16_t) millis() - u->start) >= SEN6x_EXECTIME(u->device, u->cmd));
+}
+
+/**
+ * @brief : number of words in the measured values of the sensor
+ */
+uint8_t SEN6xMulti::Words(uint8_t id)
+{
+  uint8_t i, w, cnt = 0;
+
+  for (i = 0; i < SEN6x_VALUES_FIELDS; i++) {
+    w = SEN6x_READ_BYTE(&SEN6xValuesLayout[_Units[id].device][i].word);
+    if (w != SEN6x_L_NONE && w + 1 > cnt) cnt = w + 1;
+  }
+
+  return(cnt);
+}
+
+/**
+ * @brief : I2C address of the sensor
+ */
+uint8_t SEN6xMulti::Address(uint8_t id)
+{
+  return(_Units[id].device == SEN60 ? SEN60_I2CAddress : SEN6x_I2CAddress);
+}
@@ -0,0 +1,206 @@
+/**
+ * SEN6x Library multi-sensor manager header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xMulti reads the measured values of many SEN6x sensors. Except
+ * for the SEN60 all sensors have the same I2C address (0x6B), so the
+ * sensors are connected behind TCA9548A I2C multiplexers. Up to 8
+ * multiplexers (0x70 - 0x77) with each 8 channels can be used.
+ *
+ * Compared to a SEN6x object for each sensor :
+ *  - per sensor only the state and the last measured values are kept
+ *    (26 bytes), the frame buffer is shared.
+ *  - the bus is pipelined. The command is send to the next sensor while
+ *    the previous sensors are still executing. The answer of a sensor is
+ *    read as soon as its execution time has passed. A sweep over all
+ *    sensors takes about the execution time of one command (20mS) plus
+ *    the I2C transfers.
+ *
+ * Only the measured values (as GetValues()) are read. Use a SEN6x object
+ * on the selected channel (see Select()) for other commands. Call
+ * ClearCache() of that object after selecting another channel, else the
+ * cached configuration of the previous sensor is used.
+ *
+ * Usage :
+ *
+ *  SEN6xMulti multi;
+ *
+ *  Wire.begin();
+ *  multi.begin(&Wire);
+ *  multi.add(SEN66, 0x70, 0);         // TCA9548A 0x70, channel 0
+ *  multi.add(SEN66, 0x70, 1);         // TCA9548A 0x70, channel 1
+ *  multi.add(SEN68, 0x71, 0);         // TCA9548A 0x71, channel 0
+ *  multi.start();
+ *
+ *  every second :
+ *  multi.update();                    // or sweep() and poll() in loop()
+ *  multi.GetValues(1, &val);
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_MULTI_H
+#define SEN6x_MULTI_H
+
+#include "sen6x.h"
+
+// maximum number of sensors
+#define SEN6x_MULTI_MAX         16
+
+#define TCA9548A_I2CAddress     0x70      // first multiplexer address
+#define SEN6x_NO_MUX            0x00      // sensor directly on the bus
+
+#define SEN6x_MULTI_WORDS       9         // words in measured values
+
+/**
+ * state of a sensor
+ */
+struct sen6x_multi_unit {
+  uint8_t  device;                        // SEN6x_device
+  uint8_t  mux;                           // TCA9548A address or SEN6x_NO_MUX
+  uint8_t  channel;                       // channel on TCA9548A
+  uint8_t  state;                         // SEN6x_UNIT_xxx
+  uint8_t  cmd;                           // command executing (Sen6x_Comds_offset)
+  uint8_t  result;                        // result of last read
+  uint16_t start;                         // millis() (low 16 bits) command was send
+  uint16_t words[SEN6x_MULTI_WORDS];      // last measured values as received
+};
+
+class SEN6xMulti
+{
+  public:
+
+    SEN6xMulti(void);
+
+#if not defined SEN6x_HOST
+    /**
+     * @brief : begin with the I2C port to use
+     *
+     * User must have performed the wirePort.begin() in the sketch.
+     */
+    void begin(TwoWire *wirePort);
+#endif
+
+    /**
+     * @brief : begin with a transport (all multiplexers on this bus)
+     */
+    void begin(SEN6xTransport *transport);
+
+    /**
+     * @brief : add a sensor
+     *
+     * @param d       : SEN60, SEN63C, SEN65, SEN66 or SEN68
+     * @param mux     : I2C address of TCA9548A (0x70 - 0x77) or SEN6x_NO_MUX
+     * @param channel : channel on the TCA9548A (0 - 7)
+     *
+     * @return
+     *  id of the sensor (0 = first)
+     *  -1 : too many sensors or wrong parameter
+     */
+    int8_t add(SEN6x_device d, uint8_t mux = TCA9548A_I2CAddress, uint8_t channel = 0);
+
+    /**
+     * @brief : number of sensors added
+     */
+    uint8_t GetCount(void);
+
+    /**
+     * @brief : start / stop measurement on all sensors
+     *
+     * The command is send to all sensors, after which the execution
+     * time is waited once.
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok on all sensors
+     *  else error of the first sensor that failed (see GetResult())
+     */
+    uint8_t start(void);
+    uint8_t stop(void);
+
+    /**
+     * @brief : read the measured values of all sensors
+     *
+     * sweep() starts a new sweep over all sensors and returns straight
+     * away. poll() has to be called regularly (e.g. from loop()) and
+     * returns true once all sensors have been read.
+     * update() does a sweep and waits for it to complete.
+     *
+     * Call once every second (measurement interval of the SEN6x).
+     *
+     * @return (sweep and update)
+     *  SEN6x_ERR_OK = ok on all sensors
+     *  SEN6x_ERR_CMDSTATE : a sweep is pending (sweep)
+     *  else error of the first sensor that failed (see GetResult())
+     */
+    uint8_t sweep(void);
+    bool poll(void);
+    uint8_t update(void);
+
+    /**
+     * @brief : obtain the result of the last read of a sensor
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : unknown id
+     *  else error
+     */
+    uint8_t GetResult(uint8_t id);
+
+    /**
+     * @brief : obtain the measured values of the last sweep
+     *
+     * See GetValues() and GetValuesFixed() in sen6x.h
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  else error of last read (values are zero)
+     */
+    uint8_t GetValues(uint8_t id, struct sen6x_values *v);
+    uint8_t GetValuesFixed(uint8_t id, struct sen6x_values_fixed *v);
+
+    /**
+     * @brief : select the channel of a sensor (and deselect others)
+     *
+     * Can be used to talk to the sensor with a SEN6x object on the same
+     * bus. Do not call during a sweep.
+     */
+    uint8_t Select(uint8_t id);
+
+  private:
+    SEN6xTransport *_bus;
+#if not defined SEN6x_HOST
+    SEN6xTwoWire _TwoWire;
+#endif
+    struct sen6x_multi_unit _Units[SEN6x_MULTI_MAX];
+    uint8_t _Count;
+
+    uint8_t _Mux;                         // active multiplexer (0xFF unknown)
+    uint8_t _Channel;                     // active channel
+    uint8_t _Next;                        // next sensor to send command
+    uint8_t _Done;                        // next sensor to read
+    bool _Sweep;                          // sweep pending
+
+    uint8_t _Frame[SEN6x_MULTI_WORDS * 3];  // shared frame buffer
+
+    uint8_t Broadcast(Sen6x_Comds_offset cmd);
+    uint8_t Send(uint8_t id, Sen6x_Comds_offset cmd);
+    void Read(uint8_t id);
+    bool Elapsed(uint8_t id);
+    uint8_t Words(uint8_t id);
+    uint8_t Address(uint8_t id);
+};
+
+#endif /* SEN6x_MULTI_H */
@@ -0,0 +1,293 @@
+/**
+ * SEN6x Library cadence-locked sampler file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Reads each measurement of a SEN6x once, without polling the data
+ * ready flag (see sen6x_sampler.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_sampler.h"
+
+// state of the sampler
+#define SEN6x_SAMPLER_LEARNING  0       // polling data ready flag
+#define SEN6x_SAMPLER_LOCKED    1       // reading at the learned moment
+
+SEN6xSampler::SEN6xSampler(SEN6x *sen6x)
+{
+  _sen6x = sen6x;
+  begin(SEN6x_SAMPLER_PERIOD);
+}
+
+/**
+ * @brief : (re)start learning the moment of measurement
+ */
+void SEN6xSampler::begin(uint16_t period)
+{
+  _Period = period;
+  _State = SEN6x_SAMPLER_LEARNING;
+  _Learned = 0;
+  _Open = false;
+  _Anchored = false;
+  _Early = false;
+  _Verify = SEN6x_SAMPLER_VERIFY;
+  _Last = millis() - SEN6x_SAMPLER_POLL;
+  _Checks = _Samples = 0;
+  _Resyncs = 0;
+}
+
+/**
+ * @brief : read a new measurement when it is due
+ *
+ * @return
+ *  true  : new measurement stored in v
+ *  false : no new measurement
+ */
+bool SEN6xSampler::available(struct sen6x_values *v)
+{
+  struct sen6x_values tmp;
+
+  if (! Due()) return(false);
+
+  if (! Done(_sen6x->GetValues(&tmp) == SEN6x_ERR_OK)) return(false);
+
+  memcpy(v, &tmp, sizeof(struct sen6x_values));
+  return(true);
+}
+
+bool SEN6xSampler::available(struct sen6x_values_fixed *v)
+{
+  struct sen6x_values_fixed tmp;
+
+  if (! Due()) return(false);
+
+  if (! Done(_sen6x->GetValuesFixed(&tmp) == SEN6x_ERR_OK)) return(false);
+
+  memcpy(v, &tmp, sizeof(struct sen6x_values_fixed));
+  return(true);
+}
+
+bool SEN6xSampler::IsLocked(void)
+{
+  return(_State == SEN6x_SAMPLER_LOCKED);
+}
+
+uint32_t SEN6xSampler::GetChecks(void)
+{
+  return(_Checks);
+}
+
+uint32_t SEN6xSampler::GetSamples(void)
+{
+  return(_Samples);
+}
+
+uint16_t SEN6xSampler::GetResyncs(void)
+{
+  return(_Resyncs);
+}
+
+/**
+ * @brief : determine whether a measurement should be read now
+ *
+ * While learning the data ready flag is checked every SEN6x_SAMPLER_POLL.
+ * Once locked nothing is done until the expected moment, except for
+ * the verification every SEN6x_SAMPLER_VERIFY measurements.
+ *
+ * @return
+ *  true  : read the measurement now
+ *  false : nothing to read
+ */
+bool SEN6xSampler::Due(void)
+{
+  unsigned long now = millis();
+  unsigned long lo;
+  bool open;
+
+  if (_State == SEN6x_SAMPLER_LEARNING) {
+
+    if (now - _Last < SEN6x_SAMPLER_POLL) return(false);
+
+    lo = _Last;
+    open = _Open;
+    _Last = now;
+
+    // the measurement arrives between the previous and this check
+    _Open = ! Check();
+
+    if (_Open) return(false);
+
+    if (open) Learn(lo, now);
+
+    return(true);
+  }
+
+  // check just before the measurement : must not be ready
+  if (_Verify == 0 && ! _Early) {
+
+    if ((long) (now - (_Lo - SEN6x_SAMPLER_GUARD)) < 0) return(false);
+
+    _Early = true;
+
+    // already there : the measurement is earlier than expected
+    if (Check()) {
+      Resync(false, now);
+      return(true);
+    }
+
+    return(false);
+  }
+
+  if ((long) (now - (_Hi + SEN6x_SAMPLER_MARGIN)) < 0) return(false);
+
+  if (_Verify > 0) {
+    _Verify--;
+    return(true);
+  }
+
+  // check at the measurement : must be ready
+  _Verify = SEN6x_SAMPLER_VERIFY;
+  _Early = false;
+
+  if (! Check()) {
+    Resync(true, now);
+    return(false);
+  }
+
+  return(true);
+}
+
+/**
+ * @brief : a measurement was read, expect the next one a period later
+ *
+ * If loop() was late, the measurements that were missed are skipped :
+ * the latest one was read.
+ *
+ * @param ok : true if read without error
+ *
+ * @return ok
+ */
+bool SEN6xSampler::Done(bool ok)
+{
+  unsigned long now = millis();
+
+  if (_State == SEN6x_SAMPLER_LOCKED) {
+    do {
+      _Lo += _Period;
+      _Hi += _Period;
+    } while ((long) (now - (_Hi + SEN6x_SAMPLER_MARGIN)) >= 0);
+  }
+
+  if (ok) _Samples++;
+
+  return(ok);
+}
+
+/**
+ * @brief : check the data ready flag
+ */
+bool SEN6xSampler::Check(void)
+{
+  _Checks++;
+  return(_sen6x->CheckDataReady());
+}
+
+/**
+ * @brief : the data ready flag changed between lo and hi
+ *
+ * The window is narrowed with the windows of the previous changes.
+ * After SEN6x_SAMPLER_LEARN changes the moment is known.
+ */
+void SEN6xSampler::Learn(unsigned long lo, unsigned long hi)
+{
+  unsigned long n, plo, phi;
+
+  if (_Learned == 0) Tune(lo, hi);
+  else {
+    // project the previous window to this measurement
+    n = (hi - _Hi + _Period / 2) / _Period;
+    plo = _Lo + n * _Period;
+    phi = _Hi + n * _Period;
+
+    if ((long) (plo - lo) < 0) plo = lo;
+    if ((long) (phi - hi) > 0) phi = hi;
+
+    // overlap : narrow the window, else (drift) start again with this window
+    if ((long) (phi - plo) >= 0) {
+      lo = plo;
+      hi = phi;
+    }
+    else _Learned = 0;
+  }
+
+  _Lo = lo;
+  _Hi = hi;
+
+  if (++_Learned < SEN6x_SAMPLER_LEARN) return;
+
+  _State = SEN6x_SAMPLER_LOCKED;
+  _Verify = SEN6x_SAMPLER_VERIFY;
+  _Early = false;
+  _Anchor = _Lo + (_Hi - _Lo) / 2;
+  _Anchored = true;
+}
+
+/**
+ * @brief : correct the period with the drift since the last lock
+ *
+ * @param lo, hi : window of the first change after a resync
+ */
+void SEN6xSampler::Tune(unsigned long lo, unsigned long hi)
+{
+  unsigned long mid = lo + (hi - lo) / 2;
+  unsigned long n;
+  long diff;
+
+  if (! _Anchored) return;
+
+  _Anchored = false;
+
+  n = (mid - _Anchor + _Period / 2) / _Period;
+
+  // too short to be accurate
+  if (n < SEN6x_SAMPLER_VERIFY / 2) return;
+
+  diff = (long) (mid - (_Anchor + n * _Period));
+  diff = (diff + (diff < 0 ? -(long) n / 2 : (long) n / 2)) / (long) n;
+
+  // more than 2% is not drift
+  if (diff > _Period / 50 || diff < -(_Period / 50)) return;
+
+  _Period += diff;
+}
+
+/**
+ * @brief : the measurement was not at the expected moment, learn again
+ *
+ * @param open : true if the data ready flag was not set at t
+ * @param t    : time of the check
+ */
+void SEN6xSampler::Resync(bool open, unsigned long t)
+{
+  _State = SEN6x_SAMPLER_LEARNING;
+  _Learned = 0;
+  _Open = open;
+  _Last = t;
+  _Resyncs++;
+}
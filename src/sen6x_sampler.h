@@ -0,0 +1,137 @@
+/**
+ * SEN6x Library cadence-locked sampler header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * The SEN6x has a new measurement every second. The usual way to read it
+ * is to call CheckDataReady() in loop() until it returns true and then
+ * read the values. Each check is a write, the execution time and a read
+ * on the bus, and most checks return "not ready".
+ *
+ * SEN6xSampler learns the moment in the second the sensor has a new
+ * measurement from a few changes of the data ready flag. After that it
+ * reads the values once, just after each new measurement, without
+ * checking the data ready flag first.
+ *
+ * The clock of the sensor and of the board drift. Every SEN6x_SAMPLER_VERIFY
+ * samples the sampler checks the data ready flag just before (must be not
+ * ready) and at (must be ready) the expected moment. If either is wrong
+ * the moment is learned again. The difference between the old and the
+ * new moment is used to correct the period, so the next drift takes
+ * longer.
+ *
+ * Usage :
+ *
+ *  SEN6x sen6x;
+ *  SEN6xSampler sampler(&sen6x);
+ *
+ *  setup() :
+ *  sen6x.begin(&Wire);
+ *  sen6x.start();
+ *  sampler.begin();
+ *
+ *  loop() :
+ *  if (sampler.available(&val)) { .. use val .. }
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_SAMPLER_H
+#define SEN6x_SAMPLER_H
+
+#include "sen6x.h"
+
+// the period can be changed with begin()
+#define SEN6x_SAMPLER_PERIOD    1000      // mS between measurements
+#define SEN6x_SAMPLER_POLL      25        // mS between data ready checks while learning
+#define SEN6x_SAMPLER_MARGIN    10        // mS read after the expected measurement
+#define SEN6x_SAMPLER_GUARD     60        // mS check before the expected measurement
+#define SEN6x_SAMPLER_LEARN     3         // data ready changes to learn the moment
+#define SEN6x_SAMPLER_VERIFY    30        // samples between verification
+
+class SEN6xSampler
+{
+  public:
+
+    /**
+     * @param sen6x : driver of the sensor (begin() must be called on it)
+     */
+    SEN6xSampler(SEN6x *sen6x);
+
+    /**
+     * @brief : (re)start learning the moment of measurement
+     *
+     * @param period : mS between measurements of the sensor
+     */
+    void begin(uint16_t period = SEN6x_SAMPLER_PERIOD);
+
+    /**
+     * @brief : read a new measurement when it is due
+     *
+     * Call often from loop(). It returns straight away if nothing is due,
+     * else it performs at most one data ready check or one read.
+     *
+     * @param v: pointer to structure to store (see GetValues() and
+     *           GetValuesFixed() in sen6x.h)
+     *
+     * @return
+     *  true  : new measurement stored in v
+     *  false : no new measurement (v is not changed)
+     */
+    bool available(struct sen6x_values *v);
+    bool available(struct sen6x_values_fixed *v);
+
+    /**
+     * @brief : true if the moment of measurement is known
+     */
+    bool IsLocked(void);
+
+    /**
+     * @brief : statistics
+     *
+     * GetChecks()  : data ready checks performed
+     * GetSamples() : measurements read
+     * GetResyncs() : number of times the moment was learned again
+     */
+    uint32_t GetChecks(void);
+    uint32_t GetSamples(void);
+    uint16_t GetResyncs(void);
+
+  private:
+    SEN6x *_sen6x;
+
+    uint8_t _State;                       // SEN6x_SAMPLER_xxx
+    uint16_t _Period;                     // learned period
+    unsigned long _Last;                  // time of last data ready check
+    bool _Open;                           // last check was not ready
+    unsigned long _Lo, _Hi;               // window of next measurement
+    uint8_t _Learned;                     // data ready changes seen
+    uint8_t _Verify;                      // samples until verification
+    bool _Early;                          // check before measurement done
+    unsigned long _Anchor;                // middle of window when locked
+    bool _Anchored;                       // _Anchor is valid
+
+    uint32_t _Checks, _Samples;
+    uint16_t _Resyncs;
+
+    bool Due(void);
+    bool Done(bool ok);
+    bool Check(void);
+    void Learn(unsigned long lo, unsigned long hi);
+    void Resync(bool open, unsigned long t);
+    void Tune(unsigned long lo, unsigned long hi);
+};
+
+#endif /* SEN6x_SAMPLER_H */
@@ -0,0 +1,688 @@
+/**
+ * SEN6x Library device simulator file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * A transport that behaves like a SEN6x on the I2C bus (see sen6x_sim.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ * - added fault SEN6x_SIM_STUCK and recover()
+ *********************************************************************
+ */
+
+#include "sen6x_sim.h"
+#include "Sen6xCommands.h"
+
+// product name and serial number per device
+static const char *SimName[5] = {"SEN60", "SEN63C", "SEN65", "SEN66", "SEN68"};
+static const char *SimSerial[5] = {"SIM60000001", "SIM63000001", "SIM65000001",
+                                   "SIM66000001", "SIM68000001"};
+
+// default environment
+static const struct sen6x_sim_env SimEnv = {
+  52, 87, 101, 105,             // MassPM1 .. MassPM10 (5.2 .. 10.5 ug/m3)
+  351, 412, 418, 419, 420,      // NumPM0 .. NumPM10
+  4520, 4460,                   // 45.2 %RH, 22.3 *C
+  1000, 10,                     // VOC index 100, NOx index 1
+  612, 123,                     // CO2 612ppm, HCHO 12.3 ppb
+  30215, 16712                  // raw VOC and NOx ticks
+};
+
+SEN6xSim::SEN6xSim(SEN6x_device d)
+{
+  uint8_t i;
+
+  _Env = SimEnv;
+  _First = _Period = 1000;
+  _Seed = 0x2545F491;
+  _Writes = _Reads = 0;
+  _Stale = 0;
+  _Clock = SEN6x_CLOCK_STANDARD;
+  _Stuck = false;
+  _Recovers = 0;
+
+  for (i = 0; i < SEN6x_SIM_FAULTS; i++) {
+    _FaultCnt[i] = 0;
+    _FaultRate[i] = 0;
+  }
+
+  SetDevice(d);
+}
+
+////////////////////// configuration //////////////////////////
+//************************************************************/
+
+void SEN6xSim::SetDevice(SEN6x_device d)
+{
+  _device = d;
+  PowerCycle();
+}
+
+void SEN6xSim::PowerCycle(void)
+{
+  SetDefaults();
+  _BusyTime = 0;
+}
+
+void SEN6xSim::InjectFault(SEN6x_sim_fault f, uint16_t count)
+{
+  if (f < SEN6x_SIM_FAULTS) _FaultCnt[f] = count;
+}
+
+void SEN6xSim::SetFaultRate(SEN6x_sim_fault f, uint8_t percent)
+{
+  if (f < SEN6x_SIM_FAULTS) _FaultRate[f] = percent > 100 ? 100 : percent;
+}
+
+void SEN6xSim::SetSeed(uint32_t seed)
+{
+  _Seed = seed ? seed : 1;    // xorshift can not handle zero
+}
+
+/**
+ * @brief : set errors in the device status register
+ *
+ * The STATUS_xxx_6x are translated to the bits of the
+ * device status register as decoded by ParseStatusReg()
+ */
+void SEN6xSim::SetStatus(uint16_t status)
+{
+  _Status = 0;
+
+  if (_device == SEN60) {
+    if (status & STATUS_SPEED_ERROR_6x) _Status |= 0x00000002;
+    if (status & STATUS_FAN_ERROR_6x)   _Status |= 0x00000010;
+    return;
+  }
+
+  if (status & STATUS_SPEED_ERROR_6x) _Status |= 0x00200000;
+  if (status & STATUS_CO2_1_ERROR_6x) _Status |= 0x00001000;
+  if (status & STATUS_PM_ERROR_6x)    _Status |= 0x00000800;
+  if (status & STATUS_HCHO_ERROR_6x)  _Status |= 0x00000400;
+  if (status & STATUS_CO2_2_ERROR_6x) _Status |= 0x00000200;
+  if (status & STATUS_GAS_ERROR_6x)   _Status |= 0x00000080;
+  if (status & STATUS_RHT_ERROR_6x)   _Status |= 0x00000040;
+  if (status & STATUS_FAN_ERROR_6x)   _Status |= 0x00000010;
+}
+
+void SEN6xSim::SetEnv(struct sen6x_sim_env *env)
+{
+  _Env = *env;
+}
+
+void SEN6xSim::SetCadence(uint16_t first, uint16_t period)
+{
+  _First = first;
+  _Period = period ? period : 1;
+}
+
+bool SEN6xSim::IsMeasuring(void)
+{
+  return(_Measuring);
+}
+
+uint32_t SEN6xSim::GetWrites(void)
+{
+  return(_Writes);
+}
+
+uint32_t SEN6xSim::GetReads(void)
+{
+  return(_Reads);
+}
+
+uint32_t SEN6xSim::GetStale(void)
+{
+  return(_Stale);
+}
+
+uint32_t SEN6xSim::GetClock(void)
+{
+  return(_Clock);
+}
+
+uint32_t SEN6xSim::GetRecovers(void)
+{
+  return(_Recovers);
+}
+
+////////////////////// I2C bus ////////////////////////////////
+//************************************************************/
+
+/**
+ * @brief : receive a frame (command + parameters) from the driver
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PROTOCOL : NACK
+ */
+uint8_t SEN6xSim::write(uint8_t addr, const uint8_t *buf, uint8_t len)
+{
+  uint16_t opcode, w[SEN6x_MAXBUFLENGTH / 3];
+  uint8_t i, n, cmd;
+
+  _Writes++;
+
+  if (Stuck() || addr != Address() || Fault(SEN6x_SIM_NACK)) return(SEN6x_ERR_PROTOCOL);
+
+  // still executing previous command
+  if (Busy()) return(SEN6x_ERR_PROTOCOL);
+
+  // a new command removes the previous answer
+  _ReplyValid = false;
+
+  if (len < 2 || (len - 2) % 3 != 0) return(SEN6x_ERR_PROTOCOL);
+
+  opcode = buf[0] << 8 | buf[1];
+
+  for (cmd = 0; cmd <= SEN6x_GET_SET_ALTITUDE; cmd++) {
+    if (SEN6x_OPCODE(_device, cmd) == opcode) break;
+  }
+
+  // unknown command
+  if (opcode == 0x0000 || cmd > SEN6x_GET_SET_ALTITUDE) return(SEN6x_ERR_PROTOCOL);
+
+  // parameters : 2 data bytes + CRC
+  for (i = 2, n = 0; i < len; i += 3) {
+    if (SEN6x_CRC(&buf[i]) != buf[i + 2]) return(SEN6x_ERR_PROTOCOL);
+    w[n++] = buf[i] << 8 | buf[i + 1];
+  }
+
+  if (! Allowed(cmd, n)) return(SEN6x_ERR_PROTOCOL);
+
+  _ReplyLen = 0;
+
+  if (! Execute(cmd, w, n)) return(SEN6x_ERR_PROTOCOL);
+
+  _ReplyValid = (_ReplyLen > 0);
+  _BusyTime = SEN6x_EXECTIME(_device, cmd);
+  _BusyStart = millis();
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : send the answer of the last command to the driver
+ *
+ * Bytes requested beyond the answer are returned as 0xFF (the
+ * data line is not driven)
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_PROTOCOL : NACK or short read
+ */
+uint8_t SEN6xSim::read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got)
+{
+  uint8_t i;
+
+  *got = 0;
+  _Reads++;
+
+  if (Stuck() || addr != Address() || Fault(SEN6x_SIM_NACK)) return(SEN6x_ERR_PROTOCOL);
+
+  // still executing or nothing to read
+  if (Busy() || ! _ReplyValid) return(SEN6x_ERR_PROTOCOL);
+
+  for (i = 0; i < len; i++) buf[i] = i < _ReplyLen ? _Reply[i] : 0xFF;
+
+  _ReplyValid = false;
+
+  if (len > 2 && Fault(SEN6x_SIM_CRC)) buf[2] ^= 0x01;
+
+  if (Fault(SEN6x_SIM_SHORT)) {
+    *got = len / 2;
+    return(SEN6x_ERR_PROTOCOL);
+  }
+
+  *got = len;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : I2C clock (only recorded)
+ */
+uint8_t SEN6xSim::setClock(uint32_t clock)
+{
+  _Clock = clock;
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : clock the bus free
+ */
+uint8_t SEN6xSim::recover()
+{
+  _Stuck = false;
+  _Recovers++;
+
+  return(SEN6x_ERR_OK);
+}
+
+////////////////////// device behaviour ///////////////////////
+//************************************************************/
+
+uint8_t SEN6xSim::Address(void)
+{
+  if (_device == SEN60) return(SEN60_I2CAddress);
+  return(SEN6x_I2CAddress);
+}
+
+/**
+ * @brief : check whether fault must be injected on this transfer
+ */
+bool SEN6xSim::Fault(SEN6x_sim_fault f)
+{
+  if (_FaultCnt[f] > 0) {
+    _FaultCnt[f]--;
+    return(true);
+  }
+
+  if (_FaultRate[f] == 0) return(false);
+
+  // xorshift32
+  _Seed ^= _Seed << 13;
+  _Seed ^= _Seed >> 17;
+  _Seed ^= _Seed << 5;
+
+  return(_Seed % 100 < _FaultRate[f]);
+}
+
+/**
+ * @brief : true while the bus is held low
+ */
+bool SEN6xSim::Stuck(void)
+{
+  if (! _Stuck && Fault(SEN6x_SIM_STUCK)) _Stuck = true;
+
+  return(_Stuck);
+}
+
+/**
+ * @brief : true while the last command is executing
+ */
+bool SEN6xSim::Busy(void)
+{
+  return(millis() - _BusyStart < _BusyTime);
+}
+
+/**
+ * @brief : number of measurements since start measurement
+ */
+uint32_t SEN6xSim::Samples(void)
+{
+  unsigned long t;
+
+  if (! _Measuring) return(0);
+
+  t = millis() - _MeasStart;
+
+  if (t < _First) return(0);
+
+  return((t - _First) / _Period + 1);
+}
+
+/**
+ * @brief : check the command is allowed in the current state
+ * and has the right number of parameters
+ *
+ * @param cmd : Sen6x_Comds_offset
+ * @param n   : number of parameter words
+ */
+bool SEN6xSim::Allowed(uint8_t cmd, uint8_t n)
+{
+  switch(cmd) {
+
+    // measure mode only
+    case SEN6x_STOP_MEASUREMENT:
+    case SEN6x_READ_DATA_RDY_FLAG:
+    case SEN6x_READ_MEASURED_VALUE:
+    case SEN6x_READ_RAW_VALUE:
+    case SEN6x_NUM_CONC_VALUES:
+      return(_Measuring && n == 0);
+
+    // idle mode only, no parameters
+    case SEN6x_START_MEASUREMENT:
+    case SEN6x_START_FAN_CLEANING:
+    case SEN6x_ACTIVATE_SHT_HEATER:
+      return(! _Measuring && n == 0);
+
+    // both modes, no parameters
+    case SEN6x_READ_PRODUCT_NAME:
+    case SEN6x_READ_SERIAL_NUMBER:
+    case SEN6x_READ_VERSION:
+    case SEN6x_READ_DEVICE_REGISTER:
+    case SEN6x_RD_CL_DEVICE_REGISTER:
+    case SEN6x_RESET:
+      return(n == 0);
+
+    case SEN6x_TEMP_OFFSET:
+      return(n == 4);
+
+    case SEN6x_TEMP_ACC_PARAM:
+      return(! _Measuring && n == 4);
+
+    case SEN6x_GET_SET_VOC_TUNING:
+    case SEN6x_GET_SET_NOX_TUNING:
+      return(! _Measuring && (n == 0 || n == 6));
+
+    // get in both modes, set in idle mode
+    case SEN6x_GET_SET_VOC_STATE:
+      if (n == 0) return(true);
+      return(! _Measuring && n == 4);
+
+    case SEN6x_FORCE_C02_CAL:
+      return(! _Measuring && n == 1);
+
+    case SEN6x_GET_SET_C02_CAL:
+    case SEN6x_GET_SET_ALTITUDE:
+      return(! _Measuring && n <= 1);
+
+    case SEN6x_GET_SET_AMBIENT_PRESS:
+      return(n <= 1);
+  }
+
+  return(false);
+}
+
+/**
+ * @brief : execute the command and prepare the answer
+ *
+ * @param cmd : Sen6x_Comds_offset
+ * @param w   : parameter words
+ * @param n   : number of parameter words
+ *
+ * @return
+ *  true  : ok
+ *  false : NACK
+ */
+bool SEN6xSim::Execute(uint8_t cmd, uint16_t *w, uint8_t n)
+{
+  uint8_t i;
+
+  switch(cmd) {
+
+    case SEN6x_START_MEASUREMENT:
+      _Measuring = true;
+      _MeasStart = millis();
+      _ReadSample = 0;
+      break;
+
+    case SEN6x_STOP_MEASUREMENT:
+      _Measuring = false;
+      break;
+
+    case SEN6x_READ_DATA_RDY_FLAG:
+      AddWord(Samples() > _ReadSample ? 0x0001 : 0x0000);
+      break;
+
+    case SEN6x_READ_MEASURED_VALUE:
+      if (Samples() == _ReadSample) _Stale++;
+      _ReadSample = Samples();
+      Measured();
+      break;
+
+    case SEN6x_READ_RAW_VALUE:
+      RawValues();
+      break;
+
+    case SEN6x_NUM_CONC_VALUES:
+      Concentration();
+      break;
+
+    case SEN6x_TEMP_OFFSET:
+      // slot must be 0 - 4, else no effect
+      if (w[3] <= 4) for (i = 0; i < 4; i++) _TempOffset[i] = w[i];
+      break;
+
+    case SEN6x_TEMP_ACC_PARAM:
+      for (i = 0; i < 4; i++) _TempAccel[i] = w[i];
+      break;
+
+    case SEN6x_READ_PRODUCT_NAME:
+      AddString(SimName[_device]);
+      break;
+
+    case SEN6x_READ_SERIAL_NUMBER:
+      AddString(SimSerial[_device]);
+      break;
+
+    case SEN6x_READ_VERSION:
+      AddWord(0x0400);            // firmware 4.0
+      AddWord(0x0001);            // no debug, hardware 1.x
+      AddWord(0x0001);            // hardware x.0, protocol 1.x
+      AddWord(0x0000);            // protocol x.0
+      break;
+
+    case SEN6x_READ_DEVICE_REGISTER:
+    case SEN6x_RD_CL_DEVICE_REGISTER:
+      if (_device == SEN60) AddWord(_Status & 0xffff);
+      else {
+        AddWord(_Status >> 16);
+        AddWord(_Status & 0xffff);
+      }
+
+      if (cmd == SEN6x_RD_CL_DEVICE_REGISTER) _Status = 0;
+      break;
+
+    case SEN6x_RESET:
+      SetDefaults();
+      break;
+
+    case SEN6x_START_FAN_CLEANING:
+    case SEN6x_ACTIVATE_SHT_HEATER:
+      break;
+
+    case SEN6x_GET_SET_VOC_TUNING:
+      if (n == 0) {
+        for (i = 0; i < 6; i++) AddWord(_VocTuning[i]);
+        break;
+      }
+
+      // no effect if a parameter is out of range
+      if ((int16_t) w[0] < 1  || (int16_t) w[0] > 250)  break;
+      if ((int16_t) w[1] < 1  || (int16_t) w[1] > 1000) break;
+      if ((int16_t) w[2] < 1  || (int16_t) w[2] > 1000) break;
+      if ((int16_t) w[3] < 0  || (int16_t) w[3] > 3000) break;
+      if ((int16_t) w[4] < 10 || (int16_t) w[4] > 5000) break;
+      if ((int16_t) w[5] < 1  || (int16_t) w[5] > 1000) break;
+
+      for (i = 0; i < 6; i++) _VocTuning[i] = w[i];
+      break;
+
+    case SEN6x_GET_SET_NOX_TUNING:
+      if (n == 0) {
+        for (i = 0; i < 6; i++) AddWord(_NoxTuning[i]);
+        break;
+      }
+
+      // no effect if a parameter is out of range
+      if ((int16_t) w[0] < 1 || (int16_t) w[0] > 250)  break;
+      if ((int16_t) w[1] < 1 || (int16_t) w[1] > 1000) break;
+      if ((int16_t) w[2] != 12) break;
+      if ((int16_t) w[3] < 0 || (int16_t) w[3] > 3000) break;
+      if ((int16_t) w[4] != 50) break;
+      if ((int16_t) w[5] < 1 || (int16_t) w[5] > 1000) break;
+
+      for (i = 0; i < 6; i++) _NoxTuning[i] = w[i];
+      break;
+
+    case SEN6x_GET_SET_VOC_STATE:
+      if (n == 0) {
+        for (i = 0; i < VOC_ALO_SIZE; i += 2) AddWord(_VocState[i] << 8 | _VocState[i + 1]);
+        break;
+      }
+
+      for (i = 0; i < 4; i++) {
+        _VocState[i * 2] = w[i] >> 8;
+        _VocState[i * 2 + 1] = w[i] & 0xff;
+      }
+      break;
+
+    case SEN6x_FORCE_C02_CAL:
+      // correction + 0x8000 (0xFFFF = failed)
+      if (w[0] > 40000) AddWord(0xFFFF);
+      else AddWord((uint16_t) (w[0] - _Env.CO2 + 0x8000));
+      break;
+
+    case SEN6x_GET_SET_C02_CAL:
+      if (n == 0) AddWord(_ASC ? 0x0001 : 0x0000);
+      else _ASC = (w[0] & 0x1);
+      break;
+
+    case SEN6x_GET_SET_AMBIENT_PRESS:
+      if (n == 0) AddWord(_Pressure);
+      else if (w[0] >= 700 && w[0] <= 1200) _Pressure = w[0];
+      break;
+
+    case SEN6x_GET_SET_ALTITUDE:
+      if (n == 0) AddWord(_Altitude);
+      else if (w[0] <= 3000) _Altitude = w[0];
+      break;
+
+    default:
+      return(false);
+  }
+
+  return(true);
+}
+
+/**
+ * @brief : answer for read measured values
+ */
+void SEN6xSim::Measured(void)
+{
+  bool v = (_ReadSample > 0);
+
+  AddWord(v ? _Env.MassPM1 : 0xFFFF);
+  AddWord(v ? _Env.MassPM2 : 0xFFFF);
+  AddWord(v ? _Env.MassPM4 : 0xFFFF);
+  AddWord(v ? _Env.MassPM10 : 0xFFFF);
+
+  if (_device == SEN60) {
+    AddWord(v ? _Env.NumPM0 : 0xFFFF);
+    AddWord(v ? _Env.NumPM1 : 0xFFFF);
+    AddWord(v ? _Env.NumPM2 : 0xFFFF);
+    AddWord(v ? _Env.NumPM4 : 0xFFFF);
+    AddWord(v ? _Env.NumPM10 : 0xFFFF);
+    return;
+  }
+
+  AddWord(v ? _Env.Hum : 0x7FFF);
+  AddWord(v ? _Env.Temp : 0x7FFF);
+
+  if (_device == SEN63C) {
+    AddWord(v ? _Env.CO2 : 0xFFFF);
+    return;
+  }
+
+  AddWord(v ? _Env.VOC : 0x7FFF);
+  AddWord(v ? _Env.NOX : 0x7FFF);
+
+  if (_device == SEN66) AddWord(v ? _Env.CO2 : 0xFFFF);
+  else if (_device == SEN68) AddWord(v ? _Env.HCHO : 0xFFFF);
+}
+
+/**
+ * @brief : answer for read raw values
+ */
+void SEN6xSim::RawValues(void)
+{
+  bool v = (Samples() > 0);
+
+  AddWord(v ? _Env.Hum : 0x7FFF);
+  AddWord(v ? _Env.Temp : 0x7FFF);
+
+  if (_device == SEN63C) return;
+
+  AddWord(v ? _Env.RawVOC : 0xFFFF);
+  AddWord(v ? _Env.RawNOX : 0xFFFF);
+
+  if (_device == SEN66) AddWord(v ? _Env.CO2 : 0xFFFF);
+}
+
+/**
+ * @brief : answer for read number concentration values
+ */
+void SEN6xSim::Concentration(void)
+{
+  bool v = (Samples() > 0);
+
+  AddWord(v ? _Env.NumPM0 : 0xFFFF);
+  AddWord(v ? _Env.NumPM1 : 0xFFFF);
+  AddWord(v ? _Env.NumPM2 : 0xFFFF);
+  AddWord(v ? _Env.NumPM4 : 0xFFFF);
+  AddWord(v ? _Env.NumPM10 : 0xFFFF);
+}
+
+/**
+ * @brief : add word + CRC to answer
+ */
+void SEN6xSim::AddWord(uint16_t w)
+{
+  if (_ReplyLen + 3 > SEN6x_SIM_REPLY) return;
+
+  _Reply[_ReplyLen++] = w >> 8;
+  _Reply[_ReplyLen++] = w & 0xff;
+  _Reply[_ReplyLen] = SEN6x_CRC(&_Reply[_ReplyLen - 2]);
+  _ReplyLen++;
+}
+
+/**
+ * @brief : add zero terminated string of 32 bytes to answer
+ */
+void SEN6xSim::AddString(const char *s)
+{
+  uint8_t i, b[32];
+
+  memset(b, 0x0, sizeof(b));
+  for (i = 0; i < sizeof(b) - 1 && s[i] != 0x0; i++) b[i] = s[i];
+
+  for (i = 0; i < sizeof(b); i += 2) AddWord(b[i] << 8 | b[i + 1]);
+}
+
+/**
+ * @brief : set state after power-on or reset
+ */
+void SEN6xSim::SetDefaults(void)
+{
+  static const int16_t voc[6] = {100, 12, 12, 180, 50, 230};
+  static const int16_t nox[6] = {1, 12, 12, 720, 50, 230};
+  uint8_t i;
+
+  _Measuring = false;
+  _ReadSample = 0;
+  _ReplyValid = false;
+  _ReplyLen = 0;
+  _Status = 0;
+
+  for (i = 0; i < 6; i++) {
+    _VocTuning[i] = voc[i];
+    _NoxTuning[i] = nox[i];
+  }
+
+  for (i = 0; i < 4; i++) {
+    _TempOffset[i] = 0;
+    _TempAccel[i] = 0;
+  }
+
+  memset(_VocState, 0x0, sizeof(_VocState));
+
+  _ASC = true;
+  _Pressure = 1013;
+  _Altitude = 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * SEN6x Library device simulator header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * A transport that behaves like a SEN60, SEN63C, SEN65, SEN66 or SEN68
+ * on the I2C bus. It allows to run the library (and a sketch) without a
+ * sensor, e.g. on a Linux host.
+ *
+ * The simulator :
+ *  - answers every opcode in SEN6xCommandOpCode for the selected device
+ *  - only answers on the I2C address of the device
+ *  - checks the CRC of the received parameters and answers with CRC
+ *  - will NACK a command that is not allowed in the current state
+ *    (e.g. reading values in idle mode, tuning while measuring)
+ *  - will NACK while a command is executing (execution time from
+ *    SEN6xCommandOpCode)
+ *  - has a new measurement every second after start measurement
+ *  - returns the invalid value (0xFFFF / 0x7FFF) if no measurement
+ *    is available yet
+ *  - reverts the volatile settings to default on reset
+ *
+ * Faults can be injected :
+ *  SEN6x_SIM_CRC   : a CRC in the answer is wrong
+ *  SEN6x_SIM_SHORT : less bytes than requested are returned
+ *  SEN6x_SIM_NACK  : write or read is not acknowledged
+ *  SEN6x_SIM_STUCK : the bus is held low, all transfers fail until
+ *                    recover()
+ *  SetStatus()     : set errors in the device status register
+ *
+ * Usage :
+ *
+ *  SEN6xSim sim(SEN66);
+ *  SEN6x sen6x;
+ *
+ *  sen6x.begin(&sim);
+ *  sim.InjectFault(SEN6x_SIM_CRC, 1);   // next read has CRC error
+ *
+ * extras/host has a regression test of the driver with the simulator
+ * (make test).
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ * - added fault SEN6x_SIM_STUCK and recover()
+ *********************************************************************
+ */
+#ifndef SEN6x_SIM_H
+#define SEN6x_SIM_H
+
+#include "sen6x.h"
+
+/**
+ * faults that can be injected
+ */
+enum SEN6x_sim_fault {
+  SEN6x_SIM_CRC = 0,          // CRC error in the answer
+  SEN6x_SIM_SHORT,            // answer shorter than requested
+  SEN6x_SIM_NACK,             // no acknowledge on write or read
+  SEN6x_SIM_STUCK,            // bus held low until recover()
+  SEN6x_SIM_FAULTS            // number of faults
+};
+
+/**
+ * The environment the simulator is measuring, scaled as
+ * send by the device
+ */
+struct sen6x_sim_env {
+  uint16_t MassPM1;           // ug/m3 x 10
+  uint16_t MassPM2;
+  uint16_t MassPM4;
+  uint16_t MassPM10;
+  uint16_t NumPM0;            // #/cm3 x 10
+  uint16_t NumPM1;
+  uint16_t NumPM2;
+  uint16_t NumPM4;
+  uint16_t NumPM10;
+  int16_t  Hum;               // %RH x 100
+  int16_t  Temp;              // *C x 200
+  int16_t  VOC;               // index x 10
+  int16_t  NOX;               // index x 10
+  uint16_t CO2;               // ppm
+  uint16_t HCHO;              // ppb x 10
+  uint16_t RawVOC;            // ticks
+  uint16_t RawNOX;            // ticks
+};
+
+#define SEN6x_SIM_REPLY       48    // largest answer (name / serial)
+
+class SEN6xSim : public SEN6xTransport
+{
+  public:
+
+    SEN6xSim(SEN6x_device d = SEN66);
+
+    /**
+     * @brief : select the simulated device (includes power cycle)
+     */
+    void SetDevice(SEN6x_device d);
+
+    /**
+     * @brief : power cycle the device
+     * All volatile settings are lost, measurement is stopped.
+     */
+    void PowerCycle(void);
+
+    /**
+     * @brief : inject a fault
+     *
+     * @param f     : fault to inject
+     * @param count : number of times the fault happens on the next
+     *                transfers (0 = cancel pending faults)
+     */
+    void InjectFault(SEN6x_sim_fault f, uint16_t count);
+
+    /**
+     * @brief : inject a fault at random
+     *
+     * @param f       : fault to inject
+     * @param percent : chance a transfer has this fault (0 = never)
+     */
+    void SetFaultRate(SEN6x_sim_fault f, uint8_t percent);
+
+    /**
+     * @brief : set the seed for the random faults
+     */
+    void SetSeed(uint32_t seed);
+
+    /**
+     * @brief : set errors in the device status register
+     *
+     * @param status : STATUS_xxx_6x (see sen6x.h) as returned by GetStatusReg()
+     * The errors remain until read and clear or reset.
+     */
+    void SetStatus(uint16_t status);
+
+    /**
+     * @brief : set the environment to return in the measurements
+     */
+    void SetEnv(struct sen6x_sim_env *env);
+
+    /**
+     * @brief : set the measurement cadence
+     *
+     * @param first  : mS after start measurement for the first measurement
+     * @param period : mS between measurements
+     */
+    void SetCadence(uint16_t first, uint16_t period);
+
+    /**
+     * @brief : true if measurement was started
+     */
+    bool IsMeasuring(void);
+
+    /**
+     * @brief : number of frames written / read by the driver
+     */
+    uint32_t GetWrites(void);
+    uint32_t GetReads(void);
+
+    /**
+     * @brief : number of times the measured values were read while
+     * there was no new measurement
+     */
+    uint32_t GetStale(void);
+
+    /**
+     * @brief : I2C clock as set by the driver
+     */
+    uint32_t GetClock(void);
+
+    /**
+     * @brief : number of times the bus was recovered by the driver
+     */
+    uint32_t GetRecovers(void);
+
+    uint8_t write(uint8_t addr, const uint8_t *buf, uint8_t len);
+    uint8_t read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got);
+    uint8_t setClock(uint32_t clock);
+    uint8_t recover();
+
+  private:
+    SEN6x_device _device;
+    struct sen6x_sim_env _Env;
+
+    // state
+    bool _Measuring;
+    unsigned long _MeasStart;     // time of start measurement
+    uint32_t _ReadSample;         // last measurement read
+    uint16_t _First, _Period;     // cadence
+    unsigned long _BusyStart;     // time command was received
+    uint16_t _BusyTime;           // execution time of command
+    uint32_t _Status;             // device status register
+
+    // answer of last command
+    uint8_t _Reply[SEN6x_SIM_REPLY];
+    uint8_t _ReplyLen;
+    bool _ReplyValid;
+
+    // volatile settings
+    int16_t _VocTuning[6];
+    int16_t _NoxTuning[6];
+    uint8_t _VocState[VOC_ALO_SIZE];
+    uint16_t _TempOffset[4];
+    uint16_t _TempAccel[4];
+    bool _ASC;
+    uint16_t _Pressure;
+    uint16_t _Altitude;
+
+    // fault injection
+    uint16_t _FaultCnt[SEN6x_SIM_FAULTS];
+    uint8_t _FaultRate[SEN6x_SIM_FAULTS];
+    uint32_t _Seed;
+    bool _Stuck;
+    uint32_t _Recovers;
+
+    uint32_t _Writes, _Reads;
+    uint32_t _Stale;
+    uint32_t _Clock;
+
+    uint8_t Address(void);
+    bool Fault(SEN6x_sim_fault f);
+    bool Stuck(void);
+    bool Busy(void);
+    uint32_t Samples(void);
+    bool Allowed(uint8_t cmd, uint8_t n);
+    bool Execute(uint8_t cmd, uint16_t *w, uint8_t n);
+    void Measured(void);
+    void RawValues(void);
+    void Concentration(void);
+    void AddWord(uint16_t w);
+    void AddString(const char *s);
+    void SetDefaults(void);
+};
+
+#endif /* SEN6x_SIM_H */
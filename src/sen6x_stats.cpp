@@ -0,0 +1,263 @@
+/**
+ * SEN6x Library rolling window statistics file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Mean, minimum and maximum of the measured values over moving windows
+ * (see sen6x_stats.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_stats.h"
+#include "Sen6xLayouts.h"
+
+/**
+ * @brief : read a field as float
+ *
+ * @param d : device
+ *
+ * @return value or NAN if invalid or not provided by the device
+ */
+static float StatValue(const struct sen6x_values *v, uint8_t d, uint8_t f)
+{
+  float x;
+
+  if (SEN6x_READ_BYTE(&SEN6xValuesLayout[d][f].word) == SEN6x_L_NONE) return(NAN);
+
+  if (f == SEN6x_STAT_CO2) return(v->CO2 == 0xFFFF ? NAN : v->CO2);
+
+  memcpy(&x, (const uint8_t *) v + SEN6x_READ_BYTE(&SEN6xValuesLayout[d][f].offset), sizeof(float));
+
+  return(x);
+}
+
+SEN6xStatsBase::SEN6xStatsBase(struct sen6x_window *win, struct sen6x_stat_field *fld,
+                               struct sen6x_avg *avg, struct sen6x_stat_bucket *bkt,
+                               uint8_t *deque, uint8_t windows, uint8_t buckets)
+{
+  _Win = win;
+  _Fld = fld;
+  _Avg = avg;
+  _Bkt = bkt;
+  _Deque = deque;
+  _Windows = windows;
+  _Buckets = buckets;
+  _Device = DEFAULTDEVICE;
+}
+
+void SEN6xStatsBase::SetDevice(SEN6x_device d)
+{
+  if (d > SEN68) return;
+
+  _Device = d;
+  clear();
+}
+
+/**
+ * @brief : set the length of a window
+ */
+uint8_t SEN6xStatsBase::SetWindow(uint8_t w, uint32_t seconds)
+{
+  if (w >= _Windows) return(SEN6x_ERR_PARAMETER);
+
+  if (seconds > 0 && seconds * 1000UL < _Buckets) return(SEN6x_ERR_PARAMETER);
+
+  _Win[w].span = seconds * 1000UL / _Buckets;
+  ClearWindow(w);
+
+  return(SEN6x_ERR_OK);
+}
+
+void SEN6xStatsBase::clear(void)
+{
+  uint8_t w;
+
+  for (w = 0; w < _Windows; w++) ClearWindow(w);
+}
+
+void SEN6xStatsBase::ClearWindow(uint8_t w)
+{
+  memset(&_Fld[w * SEN6x_STAT_FIELDS], 0x0, SEN6x_STAT_FIELDS * sizeof(struct sen6x_stat_field));
+  memset(&_Avg[w * SEN6x_STAT_FIELDS * _Buckets], 0x0, SEN6x_STAT_FIELDS * _Buckets * sizeof(struct sen6x_avg));
+
+  SEN6x_WindowClear(&_Win[w]);
+}
+
+void SEN6xStatsBase::add(const struct sen6x_values *v)
+{
+  add(v, millis());
+}
+
+/**
+ * @brief : add a sample to the current bucket of each window
+ *
+ * If the current bucket has ended, the window is moved first. After a
+ * gap of a window or more, the window is cleared.
+ */
+void SEN6xStatsBase::add(const struct sen6x_values *v, unsigned long t)
+{
+  struct sen6x_window *win;
+  struct sen6x_stat_bucket *b;
+  struct sen6x_avg *a;
+  uint8_t w, f, n;
+  float x;
+
+  for (w = 0; w < _Windows; w++) {
+    win = &_Win[w];
+
+    if (win->span == 0) continue;
+
+    n = SEN6x_WindowMoves(win, t);
+
+    // start again at t
+    if (n == _Buckets) {
+      ClearWindow(w);
+      SEN6x_WindowMoves(win, t);
+    }
+    else
+      while (n-- > 0) Move(w);
+
+    for (f = 0; f < SEN6x_STAT_FIELDS; f++) {
+      x = StatValue(v, _Device, f);
+      if (isnan(x)) continue;
+
+      a = &_Avg[(w * SEN6x_STAT_FIELDS + f) * _Buckets + win->cur];
+      b = &_Bkt[(w * SEN6x_STAT_FIELDS + f) * _Buckets + win->cur];
+
+      if (a->count == 0) b->min = b->max = x;
+      else {
+        if (x < b->min) b->min = x;
+        if (x > b->max) b->max = x;
+      }
+
+      SEN6x_AvgAdd(a, x);
+    }
+  }
+}
+
+/**
+ * @brief : move the window one bucket
+ *
+ * The current bucket is added to the running sums and deques. The oldest
+ * bucket is removed from them and becomes the (empty) current bucket.
+ */
+void SEN6xStatsBase::Move(uint8_t w)
+{
+  struct sen6x_window *win = &_Win[w];
+  struct sen6x_stat_field *fld;
+  struct sen6x_stat_bucket *b;
+  struct sen6x_avg *a;
+  uint8_t *dq, f, cur, next;
+  bool sum;
+
+  cur = win->cur;
+  sum = SEN6x_WindowMove(win);
+  next = win->cur;
+
+  for (f = 0; f < SEN6x_STAT_FIELDS; f++) {
+    fld = &_Fld[w * SEN6x_STAT_FIELDS + f];
+    a = &_Avg[(w * SEN6x_STAT_FIELDS + f) * _Buckets];
+    b = &_Bkt[(w * SEN6x_STAT_FIELDS + f) * _Buckets];
+    dq = &_Deque[(w * SEN6x_STAT_FIELDS + f) * _Buckets * 2];
+
+    // current bucket is complete
+    if (a[cur].count > 0) {
+      Push(dq, &fld->minHead, &fld->minLen, b, cur, false);
+      Push(&dq[_Buckets], &fld->maxHead, &fld->maxLen, b, cur, true);
+    }
+
+    // oldest bucket leaves the window (only it can be first in a deque)
+    if (a[next].count > 0) {
+      if (fld->minLen > 0 && dq[fld->minHead] == next) {
+        fld->minHead = (fld->minHead + 1) % _Buckets;
+        fld->minLen--;
+      }
+
+      if (fld->maxLen > 0 && dq[_Buckets + fld->maxHead] == next) {
+        fld->maxHead = (fld->maxHead + 1) % _Buckets;
+        fld->maxLen--;
+      }
+    }
+
+    SEN6x_AvgMove(&fld->total, a, cur, next);
+    if (sum) SEN6x_AvgSum(&fld->total, a, _Buckets, next);
+  }
+}
+
+/**
+ * @brief : add bucket i to the back of a monotonic deque
+ *
+ * Buckets at the back that can never be the minimum (maximum) again are
+ * removed, as bucket i is newer and at least as small (large).
+ */
+void SEN6xStatsBase::Push(uint8_t *dq, uint8_t *head, uint8_t *len, const struct sen6x_stat_bucket *b, uint8_t i, bool max)
+{
+  uint8_t back;
+
+  while (*len > 0) {
+    back = dq[(*head + *len - 1) % _Buckets];
+
+    if (max ? b[back].max > b[i].max : b[back].min < b[i].min) break;
+
+    (*len)--;
+  }
+
+  dq[(*head + *len) % _Buckets] = i;
+  (*len)++;
+}
+
+/**
+ * @brief : get the statistics of a field in a window
+ *
+ * The completed buckets and the current bucket are combined.
+ */
+bool SEN6xStatsBase::Get(uint8_t w, uint8_t field, struct sen6x_stat *s)
+{
+  struct sen6x_stat_field *fld;
+  struct sen6x_stat_bucket *b, *cur;
+  struct sen6x_avg *a;
+  uint32_t count;
+  uint8_t *dq;
+
+  if (w >= _Windows || field >= SEN6x_STAT_FIELDS || _Win[w].span == 0) return(false);
+
+  fld = &_Fld[w * SEN6x_STAT_FIELDS + field];
+  a = &_Avg[(w * SEN6x_STAT_FIELDS + field) * _Buckets + _Win[w].cur];
+  b = &_Bkt[(w * SEN6x_STAT_FIELDS + field) * _Buckets];
+  cur = &b[_Win[w].cur];
+  dq = &_Deque[(w * SEN6x_STAT_FIELDS + field) * _Buckets * 2];
+
+  count = fld->total.count + a->count;
+  if (count == 0) return(false);
+
+  s->mean = SEN6x_AvgMean(&fld->total, a);
+  s->count = count > 0xFFFF ? 0xFFFF : count;
+
+  if (fld->minLen > 0) {
+    s->min = b[dq[fld->minHead]].min;
+    s->max = b[dq[_Buckets + fld->maxHead]].max;
+    if (a->count > 0 && cur->min < s->min) s->min = cur->min;
+    if (a->count > 0 && cur->max > s->max) s->max = cur->max;
+  }
+  else {
+    s->min = cur->min;
+    s->max = cur->max;
+  }
+
+  return(true);
+}
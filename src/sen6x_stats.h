@@ -0,0 +1,212 @@
+/**
+ * SEN6x Library rolling window statistics header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xStats<WINDOWS, BUCKETS> keeps the mean, minimum and maximum of
+ * every field of struct sen6x_values over up to WINDOWS windows (e.g. 1
+ * minute, 15 minutes and 1 hour) at the same time.
+ *
+ * A window is split in BUCKETS buckets. A bucket keeps the sum, minimum,
+ * maximum and count of the samples in its part of the window. When a
+ * bucket is full, the oldest bucket leaves the window :
+ *  - the sum and count of the window are updated (running sums, see
+ *    sen6x_window.h)
+ *  - the minimum and maximum are kept in a monotonic deque of buckets,
+ *    the first bucket in the deque holds the minimum (maximum).
+ *
+ * The cost of a sample does not depend on the length of a window, and
+ * the memory is set at compile time :
+ *   WINDOWS * SEN6x_STAT_FIELDS * BUCKETS * 18 bytes (about)
+ *   SEN6xStats<3, 12> : about 10K (ESP32, RP2040, not an UNO)
+ *
+ * The window moves a bucket at a time. A window of 3600 seconds with
+ * 12 buckets covers the last 3300 - 3600 seconds. Invalid values (NAN
+ * or CO2 0xFFFF, e.g. just after start) and fields the device does not
+ * provide (see SetDevice()) are not counted.
+ *
+ * Usage :
+ *
+ *  SEN6xStats<3, 12> stats;
+ *
+ *  setup() :
+ *  stats.SetDevice(SEN68);            // default SEN66
+ *  stats.SetWindow(0, 60);            // window 0 : 1 minute
+ *  stats.SetWindow(1, 900);           // window 1 : 15 minutes
+ *  stats.SetWindow(2, 3600);          // window 2 : 1 hour
+ *
+ *  loop() :
+ *  if (sen6x.GetValues(&val) == SEN6x_ERR_OK) stats.add(&val);
+ *
+ *  if (stats.Get(2, SEN6x_STAT_CO2, &s)) Serial.print(s.mean);
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_STATS_H
+#define SEN6x_STATS_H
+
+#include "sen6x_window.h"
+
+// fields of struct sen6x_values
+#define SEN6x_STAT_MASSPM1      0
+#define SEN6x_STAT_MASSPM2      1
+#define SEN6x_STAT_MASSPM4      2
+#define SEN6x_STAT_MASSPM10     3
+#define SEN6x_STAT_NUMPM0       4
+#define SEN6x_STAT_NUMPM1       5
+#define SEN6x_STAT_NUMPM2       6
+#define SEN6x_STAT_NUMPM4       7
+#define SEN6x_STAT_NUMPM10      8
+#define SEN6x_STAT_HUM          9
+#define SEN6x_STAT_TEMP         10
+#define SEN6x_STAT_VOC          11
+#define SEN6x_STAT_NOX          12
+#define SEN6x_STAT_CO2          13
+#define SEN6x_STAT_HCHO         14
+#define SEN6x_STAT_FIELDS       15
+
+/**
+ * result of a field in a window
+ */
+struct sen6x_stat {
+  float mean;
+  float min;
+  float max;
+  uint16_t count;                         // valid samples
+};
+
+/**
+ * minimum and maximum of a bucket (sum and count in struct sen6x_avg)
+ */
+struct sen6x_stat_bucket {
+  float min;
+  float max;
+};
+
+/**
+ * a field in a window
+ */
+struct sen6x_stat_field {
+  struct sen6x_avg_total total;           // of buckets before current
+  uint8_t minHead, minLen;                // deque of buckets for minimum
+  uint8_t maxHead, maxLen;                // deque of buckets for maximum
+};
+
+/**
+ * the statistics, storage is provided by SEN6xStats
+ */
+class SEN6xStatsBase
+{
+  public:
+
+    /**
+     * @brief : set the length of a window
+     *
+     * The statistics of the window are cleared.
+     *
+     * @param w       : window (0 - WINDOWS-1)
+     * @param seconds : length of window (0 : not used)
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PARAMETER : wrong window or shorter than a mS per bucket
+     */
+    uint8_t SetWindow(uint8_t w, uint32_t seconds);
+
+    /**
+     * @brief : set the device the values are from (default SEN66)
+     *
+     * Only the fields the device provides are counted. The statistics
+     * are cleared.
+     */
+    void SetDevice(SEN6x_device d);
+
+    /**
+     * @brief : clear the statistics of all windows
+     */
+    void clear(void);
+
+    /**
+     * @brief : add a sample
+     *
+     * @param v : measured values (see GetValues() in sen6x.h)
+     * @param t : time of the sample in mS (default millis())
+     */
+    void add(const struct sen6x_values *v);
+    void add(const struct sen6x_values *v, unsigned long t);
+
+    /**
+     * @brief : get the statistics of a field in a window
+     *
+     * @param w     : window
+     * @param field : SEN6x_STAT_xxx
+     * @param s     : to store the statistics
+     *
+     * @return
+     *  true  : ok
+     *  false : wrong window or field, or no valid samples
+     */
+    bool Get(uint8_t w, uint8_t field, struct sen6x_stat *s);
+
+  protected:
+    SEN6xStatsBase(struct sen6x_window *win, struct sen6x_stat_field *fld,
+                   struct sen6x_avg *avg, struct sen6x_stat_bucket *bkt,
+                   uint8_t *deque, uint8_t windows, uint8_t buckets);
+
+  private:
+    struct sen6x_window *_Win;
+    struct sen6x_stat_field *_Fld;        // [window][field]
+    struct sen6x_avg *_Avg;               // [window][field][bucket]
+    struct sen6x_stat_bucket *_Bkt;       // [window][field][bucket]
+    uint8_t *_Deque;                      // [window][field][min, max][bucket]
+    uint8_t _Windows;
+    uint8_t _Buckets;
+    uint8_t _Device;
+
+    void ClearWindow(uint8_t w);
+    void Move(uint8_t w);
+    void Push(uint8_t *dq, uint8_t *head, uint8_t *len, const struct sen6x_stat_bucket *b, uint8_t i, bool max);
+};
+
+/**
+ * @param WINDOWS : number of windows (1 - 255)
+ * @param BUCKETS : buckets in a window (2 - 255), more is a smoother
+ *                  moving window and more memory
+ */
+template<uint8_t WINDOWS, uint8_t BUCKETS>
+class SEN6xStats : public SEN6xStatsBase
+{
+  static_assert(WINDOWS > 0, "at least 1 window");
+  static_assert(BUCKETS > 1, "at least 2 buckets");
+
+  public:
+    SEN6xStats(void) : SEN6xStatsBase(_W, _F, _A, _B, _D, WINDOWS, BUCKETS) {
+      uint8_t w;
+
+      memset(_W, 0x0, sizeof(_W));
+      for (w = 0; w < WINDOWS; w++) _W[w].buckets = BUCKETS;
+      clear();
+    }
+
+  private:
+    struct sen6x_window _W[WINDOWS];
+    struct sen6x_stat_field _F[WINDOWS * SEN6x_STAT_FIELDS];
+    struct sen6x_avg _A[WINDOWS * SEN6x_STAT_FIELDS * BUCKETS];
+    struct sen6x_stat_bucket _B[WINDOWS * SEN6x_STAT_FIELDS * BUCKETS];
+    uint8_t _D[WINDOWS * SEN6x_STAT_FIELDS * BUCKETS * 2];
+};
+
+#endif /* SEN6x_STATS_H */
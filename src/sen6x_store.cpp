@@ -0,0 +1,109 @@
+/**
+ * SEN6x Library storage file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Default storage functions and the file storage for a Linux host
+ * (see sen6x_store.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_store.h"
+
+bool SEN6xStore::commit()
+{
+  return(true);
+}
+
+#if defined SEN6x_HOST
+
+#include <unistd.h>
+
+SEN6xFileStore::SEN6xFileStore(void)
+{
+  _fp = NULL;
+}
+
+SEN6xFileStore::~SEN6xFileStore(void)
+{
+  if (_fp) fclose(_fp);
+}
+
+/**
+ * @brief : open the file (created if it does not exist)
+ */
+uint8_t SEN6xFileStore::begin(const char *path)
+{
+  if (_fp) fclose(_fp);
+
+  _fp = fopen(path, "r+b");
+
+  if (_fp == NULL) _fp = fopen(path, "w+b");
+
+  if (_fp == NULL) return(SEN6x_ERR_STORAGE);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : read from the file
+ *
+ * Bytes beyond the end of the file read as 0xFF (as erased EEPROM).
+ */
+bool SEN6xFileStore::read(uint16_t addr, uint8_t *buf, uint8_t len)
+{
+  size_t got;
+
+  if (_fp == NULL) return(false);
+
+  memset(buf, 0xFF, len);
+
+  if (fseek(_fp, addr, SEEK_SET) != 0) return(false);
+
+  got = fread(buf, 1, len, _fp);
+
+  if (got < len) clearerr(_fp);
+
+  return(true);
+}
+
+/**
+ * @brief : write to the file
+ */
+bool SEN6xFileStore::write(uint16_t addr, const uint8_t *buf, uint8_t len)
+{
+  if (_fp == NULL) return(false);
+
+  if (fseek(_fp, addr, SEEK_SET) != 0) return(false);
+
+  return(fwrite(buf, 1, len, _fp) == len);
+}
+
+/**
+ * @brief : flush to disk
+ */
+bool SEN6xFileStore::commit()
+{
+  if (_fp == NULL) return(false);
+
+  if (fflush(_fp) != 0) return(false);
+
+  return(fsync(fileno(_fp)) == 0);
+}
+
+#endif // SEN6x_HOST
@@ -0,0 +1,110 @@
+/**
+ * SEN6x Library storage interface
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * A storage keeps data of the library across a power cycle of the
+ * board (e.g. the VOC algorithm state, see sen6x_checkpoint.h).
+ *
+ * Available storages:
+ *  SEN6xEEPROM    : Arduino EEPROM library (see sen6x_eeprom.h). On ESP32,
+ *                   ESP8266 and RP2040 the EEPROM library keeps the data
+ *                   in a flash page.
+ *  SEN6xFileStore : a file on a Linux host
+ *
+ * To add your own storage, derive from SEN6xStore and implement read()
+ * and write(). Optional commit() can be overruled in case written data
+ * has to be flushed to the medium.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_STORE_H
+#define SEN6x_STORE_H
+
+#include "sen6x.h"
+
+class SEN6xStore
+{
+  public:
+
+    /**
+     * @brief : read from the storage
+     *
+     * @param addr : offset in the storage
+     * @param buf  : to store the data
+     * @param len  : number of bytes to read
+     *
+     * @return
+     *  true  : ok
+     *  false : error
+     */
+    virtual bool read(uint16_t addr, uint8_t *buf, uint8_t len) = 0;
+
+    /**
+     * @brief : write to the storage
+     *
+     * @param addr : offset in the storage
+     * @param buf  : data to write
+     * @param len  : number of bytes to write
+     *
+     * @return
+     *  true  : ok
+     *  false : error
+     */
+    virtual bool write(uint16_t addr, const uint8_t *buf, uint8_t len) = 0;
+
+    /**
+     * @brief : make written data permanent
+     *
+     * Default : nothing to do
+     */
+    virtual bool commit();
+};
+
+#if defined SEN6x_HOST
+
+#include <stdio.h>
+
+/**
+ * storage in a file on a Linux host
+ */
+class SEN6xFileStore : public SEN6xStore
+{
+  public:
+
+    SEN6xFileStore(void);
+    ~SEN6xFileStore(void);
+
+    /**
+     * @brief : open the file (created if it does not exist)
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_STORAGE : can not open file
+     */
+    uint8_t begin(const char *path);
+
+    bool read(uint16_t addr, uint8_t *buf, uint8_t len);
+    bool write(uint16_t addr, const uint8_t *buf, uint8_t len);
+    bool commit();
+
+  private:
+    FILE *_fp;
+};
+
+#endif // SEN6x_HOST
+
+#endif /* SEN6x_STORE_H */
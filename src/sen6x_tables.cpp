@@ -0,0 +1,32 @@
+/**
+ * SEN6x Library tables file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * The run time copy of the tables in Sen6xCommands.h and Sen6xLayouts.h.
+ * The tables in the headers are constexpr and are only used in constant
+ * expressions, so the library holds one copy (in flash on AVR).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "Sen6xCommands.h"
+#include "Sen6xLayouts.h"
+
+const struct sen6x_commands SEN6xCommands PROGMEM = SEN6xCommandTable;
+
+const struct sen6x_layouts SEN6xLayouts PROGMEM = SEN6xLayoutTable;
@@ -0,0 +1,743 @@
+/**
+ * SEN6x Library compile-time device header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * SEN6xT<device> is a driver for ONE type of SEN6x, selected at compile
+ * time. The opcodes, execution times, frame lengths and field offsets
+ * are constants. Calling a routine the device does not support (e.g.
+ * ForceCO2Recal() on a SEN65) is a compile error.
+ *
+ * Compared to the SEN6x class there is no opcode or layout table in
+ * flash or RAM, no device detection and no code for the other devices.
+ * The split-phase transaction engine and the clock fallback are NOT
+ * included.
+ *
+ * Usage :
+ *
+ *  #include "sen6x_template.h"
+ *
+ *  SEN6xTwoWire bus(&Wire);   // or any other transport
+ *  SEN6xT<SEN66> sen6x;
+ *
+ *  Wire.begin();
+ *  sen6x.begin(&bus);
+ *  sen6x.GetValues(&val);
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_TEMPLATE_H
+#define SEN6x_TEMPLATE_H
+
+#include "sen6x.h"
+#include "Sen6xCommands.h"
+#include "Sen6xLayouts.h"
+
+// name and serial number : 32 bytes + 16 CRC
+#ifdef SEN6x_MAX_32_TO_EXPECT
+  #define SEN6xT_INFO_FRAME   30
+#else
+  #define SEN6xT_INFO_FRAME   48
+#endif
+
+template<SEN6x_device D>
+class SEN6xT
+{
+  public:
+
+    /** I2C address of the device */
+    static constexpr uint8_t Address = (D == SEN60) ? SEN60_I2CAddress : SEN6x_I2CAddress;
+
+    /** number of words in the measured values frame */
+    static constexpr uint8_t ValuesWords = (D == SEN63C) ? 7 : (D == SEN65) ? 8 : 9;
+
+    /** number of words in the raw values frame */
+    static constexpr uint8_t RawWords = (D == SEN63C) ? 2 : (D == SEN66) ? 5 : 4;
+
+    SEN6xT(void) : _transport(NULL), _started(false), _restart(false),
+                   _config(false), _configRestart(false) {}
+
+    /**
+     * @brief : begin with assigment of a transport
+     *
+     * User must have initialized the transport in the sketch.
+     *
+     * @return
+     * true  : device responded
+     * false : no response
+     */
+    bool begin(SEN6xTransport *transport) {
+      _transport = transport;
+      return(probe());
+    }
+
+    /**
+     * @brief : Perform SEN6x instructions
+     */
+    bool probe() {
+      struct sen6x_version v;
+      return(GetVersion(&v) == SEN6x_ERR_OK);
+    }
+
+    bool reset() {
+      if (Exec<SEN6x_RESET>() != SEN6x_ERR_OK) return(false);
+      _started = false;
+      return(true);
+    }
+
+    bool start() {
+      if (_started) return(true);
+      if (Exec<SEN6x_START_MEASUREMENT>() != SEN6x_ERR_OK) return(false);
+      _started = true;
+      return(true);
+    }
+
+    bool stop() {
+      if (! _started) return(true);
+      if (Exec<SEN6x_STOP_MEASUREMENT>() != SEN6x_ERR_OK) return(false);
+      _started = false;
+      return(true);
+    }
+
+    /**
+     * @brief : perform a clean (fan at maximum speed for 10 seconds)
+     * Sensor will be started with the next request for values.
+     */
+    bool clean() {
+      if (! CheckToStop()) return(false);
+      return(Exec<SEN6x_START_FAN_CLEANING>() == SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : stop the measurement once for a number of configuration
+     * calls and restart once on commit() (see beginConfig() in sen6x.h)
+     */
+    uint8_t beginConfig() {
+      if (_config) return(SEN6x_ERR_CMDSTATE);
+      _configRestart = _started;
+      if (! stop()) return(SEN6x_ERR_PROTOCOL);
+      _config = true;
+      return(SEN6x_ERR_OK);
+    }
+
+    uint8_t commit() {
+      if (! _config) return(SEN6x_ERR_CMDSTATE);
+      _config = false;
+      _restart = _configRestart;
+      if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : retrieve information from the SEN6x
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  else error
+     */
+    uint8_t GetVersion(struct sen6x_version *v) {
+      uint8_t f[12], ret;
+
+      memset(v, 0x0, sizeof(struct sen6x_version));
+
+      ret = Exec<SEN6x_READ_VERSION>(NULL, 0, f, sizeof(f));
+
+      if (ret == SEN6x_ERR_OK) {
+        v->F_major = f[0];
+        v->F_minor = f[1];
+        v->F_debug = f[3];
+        v->H_major = f[4];
+        v->H_minor = f[6];
+        v->P_major = f[7];
+        v->P_minor = f[9];
+        v->L_major = DRIVER_MAJOR_6x;
+        v->L_minor = DRIVER_MINOR_6x;
+      }
+
+      return(ret);
+    }
+
+    uint8_t GetSerialNumber(char *ser, uint8_t len) {
+      return(GetInfo<SEN6x_READ_SERIAL_NUMBER>(ser, len));
+    }
+
+    // Applies to: SEN63C, SEN65, SEN66, SEN68
+    uint8_t GetProductName(char *ser, uint8_t len) {
+      return(GetInfo<SEN6x_READ_PRODUCT_NAME>(ser, len));
+    }
+
+    /**
+     * @brief : Read Device Status from the SEN6x (see SEN6x::GetStatusReg())
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok, no isues found
+     *  SEN6x_ERR_OUTOFRANGE, ERROR status feedback
+     *  else error
+     */
+    uint8_t GetStatusReg(uint16_t *status) {
+      uint8_t f[6], ret;
+
+      *status = STATUS_OK_6x;
+
+      ret = Exec<SEN6x_READ_DEVICE_REGISTER>(NULL, 0, f, D == SEN60 ? 3 : 6);
+
+      if (ret != SEN6x_ERR_OK) return(ret);
+
+      if (D == SEN60) {
+        if (f[1] & 0b00000010) *status |= STATUS_SPEED_ERROR_6x;
+        if (f[1] & 0b00010000) *status |= STATUS_FAN_ERROR_6x;
+      }
+      else {
+        if (f[1] & 0b00100000) *status |= STATUS_SPEED_ERROR_6x;
+
+        if (f[3] & 0b00000010) *status |= STATUS_CO2_2_ERROR_6x;
+        if (f[3] & 0b00000100) *status |= STATUS_HCHO_ERROR_6x;
+        if (f[3] & 0b00001000) *status |= STATUS_PM_ERROR_6x;
+        if (f[3] & 0b00010000) *status |= STATUS_CO2_1_ERROR_6x;
+
+        if (f[4] & 0b10000000) *status |= STATUS_GAS_ERROR_6x;
+        if (f[4] & 0b01000000) *status |= STATUS_RHT_ERROR_6x;
+        if (f[4] & 0b00010000) *status |= STATUS_FAN_ERROR_6x;
+      }
+
+      if (*status != STATUS_OK_6x) return(SEN6x_ERR_OUTOFRANGE);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : check for data ready
+     */
+    bool CheckDataReady() {
+      uint8_t f[3];
+
+      _restart = ! _started;
+      if (! CheckWasStarted()) return(false);
+
+      if (Exec<SEN6x_READ_DATA_RDY_FLAG>(NULL, 0, f, sizeof(f)) != SEN6x_ERR_OK) return(false);
+
+      return(f[1] == 1);
+    }
+
+    /**
+     * @brief : read all values from the sensor (see SEN6x::GetValues())
+     */
+    uint8_t GetValues(struct sen6x_values *v) {
+      uint8_t f[ValuesWords * 3], ret;
+
+      _restart = ! _started;
+      if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+      else ret = Exec<SEN6x_READ_MEASURED_VALUE>(NULL, 0, f, sizeof(f));
+
+      if (ret != SEN6x_ERR_OK) {
+        memset(v, 0x0, sizeof(struct sen6x_values));
+        return(ret);
+      }
+
+      Decode<LayoutValues, 0>::Frame(f, (uint8_t *) v);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : read all values as integers (see SEN6x::GetValuesFixed())
+     */
+    uint8_t GetValuesFixed(struct sen6x_values_fixed *v) {
+      uint8_t f[ValuesWords * 3], ret;
+
+      _restart = ! _started;
+      if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+      else ret = Exec<SEN6x_READ_MEASURED_VALUE>(NULL, 0, f, sizeof(f));
+
+      if (ret != SEN6x_ERR_OK) {
+        memset(v, 0x0, sizeof(struct sen6x_values_fixed));
+        return(ret);
+      }
+
+      Decode<LayoutValues, 0>::Fixed(f, (uint8_t *) v);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : read the PM number concentration
+     */
+    uint8_t GetConcentration(struct sen6x_concentration_values *v) {
+      // for SEN60 it is in the measured values
+      const Sen6x_Comds_offset C = (D == SEN60) ? SEN6x_READ_MEASURED_VALUE : SEN6x_NUM_CONC_VALUES;
+      uint8_t f[(D == SEN60 ? 9 : 5) * 3], ret;
+
+      _restart = ! _started;
+      if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+      else ret = Exec<C>(NULL, 0, f, sizeof(f));
+
+      if (ret != SEN6x_ERR_OK) {
+        memset(v, 0x0, sizeof(struct sen6x_concentration_values));
+        return(ret);
+      }
+
+      Decode<LayoutConc, 0>::Frame(f, (uint8_t *) v);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : read RAW values
+     * Applies to: SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t GetRawValues(struct sen6x_raw_values *v) {
+      uint8_t f[RawWords * 3], ret;
+
+      _restart = ! _started;
+      if (! CheckWasStarted()) ret = SEN6x_ERR_PROTOCOL;
+      else ret = Exec<SEN6x_READ_RAW_VALUE>(NULL, 0, f, sizeof(f));
+
+      if (ret != SEN6x_ERR_OK) {
+        memset(v, 0x0, sizeof(struct sen6x_raw_values));
+        return(ret);
+      }
+
+      Decode<LayoutRaw, 0>::Frame(f, (uint8_t *) v);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : temperature (see SEN6x)
+     * Applies to: SEN63C, SEN65, SEN66, SEN68
+     */
+    uint8_t SetTempAccelMode(sen6x_RHT_comp *table) {
+      uint16_t p[4] = {table->K, table->P, table->T1, table->T2};
+
+      // CAN NOT be done when measuring, will be restarted with next value request
+      if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      return(Exec<SEN6x_TEMP_ACC_PARAM>(p, 4));
+    }
+
+    uint8_t SetTmpComp(sen6x_tmp_comp *tmp) {
+      uint16_t p[4];
+
+      p[0] = (int16_t) (tmp->offset * 200);
+      p[1] = (int16_t) (tmp->slope * 1000);
+      p[2] = tmp->time;
+      p[3] = tmp->slot > 4 ? 4 : tmp->slot;
+
+      return(Exec<SEN6x_TEMP_OFFSET>(p, 4));
+    }
+
+    bool ActivateSHTHeater() {
+      if (! CheckToStop()) return(false);
+      return(Exec<SEN6x_ACTIVATE_SHT_HEATER>() == SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : VOC (see SEN6x)
+     * Applies to: SEN65, SEN66, SEN68
+     */
+    uint8_t GetVocAlgorithmState(uint8_t *table, uint8_t tablesize) {
+      uint8_t f[VOC_ALO_SIZE / 2 * 3], ret, i;
+
+      if (tablesize < VOC_ALO_SIZE) return(SEN6x_ERR_PARAMETER);
+
+      ret = Exec<SEN6x_GET_SET_VOC_STATE>(NULL, 0, f, sizeof(f));
+
+      if (ret == SEN6x_ERR_OK) {
+        for (i = 0; i < VOC_ALO_SIZE; i++) table[i] = f[i / 2 * 3 + i % 2];
+      }
+
+      return(ret);
+    }
+
+    uint8_t SetVocAlgorithmState(uint8_t *table, uint8_t tablesize) {
+      uint16_t p[VOC_ALO_SIZE / 2];
+      uint8_t ret, i;
+
+      if (tablesize < VOC_ALO_SIZE) return(SEN6x_ERR_PARAMETER);
+
+      if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      for (i = 0; i < VOC_ALO_SIZE / 2; i++) p[i] = table[i * 2] << 8 | table[i * 2 + 1];
+
+      ret = Exec<SEN6x_GET_SET_VOC_STATE>(p, VOC_ALO_SIZE / 2);
+
+      if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    uint8_t GetVocAlgorithm(sen6x_xox *voc) {
+      return(GetXox<SEN6x_GET_SET_VOC_TUNING>(voc));
+    }
+
+    uint8_t SetVocAlgorithm(sen6x_xox *voc) {
+      // check limits (else default according to datasheet)
+      if (voc->IndexOffset > 250 || voc->IndexOffset < 1) voc->IndexOffset = 100;
+      if (voc->LearnTimeOffsetHours > 1000 || voc->LearnTimeOffsetHours < 1) voc->LearnTimeOffsetHours = 12;
+      if (voc->LearnTimeGainHours > 1000 || voc->LearnTimeGainHours < 1) voc->LearnTimeGainHours = 12;
+      if (voc->GateMaxDurationMin > 3000 || voc->GateMaxDurationMin < 1) voc->GateMaxDurationMin = 180;
+      if (voc->stdInitial > 5000 || voc->stdInitial < 10) voc->stdInitial = 50;
+      if (voc->GainFactor > 1000 || voc->GainFactor < 1) voc->GainFactor = 230;
+
+      return(SetXox<SEN6x_GET_SET_VOC_TUNING>(voc));
+    }
+
+    /**
+     * @brief : NOx (see SEN6x)
+     * Applies to: SEN65, SEN66, SEN68
+     */
+    uint8_t GetNoxAlgorithm(sen6x_xox *nox) {
+      return(GetXox<SEN6x_GET_SET_NOX_TUNING>(nox));
+    }
+
+    uint8_t SetNoxAlgorithm(sen6x_xox *nox) {
+      // MUST be / strongly advised values (according to datasheet))
+      nox->LearnTimeGainHours = 12;
+      nox->stdInitial = 50;
+
+      // check limits
+      if (nox->IndexOffset > 250 || nox->IndexOffset < 1) nox->IndexOffset = 1;
+      if (nox->LearnTimeOffsetHours > 1000 || nox->LearnTimeOffsetHours < 1) nox->LearnTimeOffsetHours = 12;
+      if (nox->GateMaxDurationMin > 3000 || nox->GateMaxDurationMin < 1) nox->GateMaxDurationMin = 720;
+      if (nox->GainFactor > 1000 || nox->GainFactor < 1) nox->GainFactor = 230;
+
+      return(SetXox<SEN6x_GET_SET_NOX_TUNING>(nox));
+    }
+
+    /**
+     * @brief : CO2 (see SEN6x)
+     * Applies to: SEN63C, SEN66
+     */
+    uint8_t ForceCO2Recal(uint16_t *val) {
+      uint8_t f[3], ret;
+
+      if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      ret = Exec<SEN6x_FORCE_C02_CAL>(val, 1, f, sizeof(f));
+
+      if (ret == SEN6x_ERR_OK) *val = Word(f, 0);
+
+      if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    uint8_t GetCo2SelfCalibratrion(bool *val) {
+      uint16_t w;
+      uint8_t ret = GetWord<SEN6x_GET_SET_C02_CAL>(&w, true);
+
+      if (ret == SEN6x_ERR_OK) *val = (bool) (w & 0xff);
+
+      return(ret);
+    }
+
+    uint8_t SetCo2SelfCalibratrion(bool val) {
+      return(SetWord<SEN6x_GET_SET_C02_CAL>(val ? 1 : 0, true));
+    }
+
+    uint8_t GetAmbientPressure(uint16_t *val) {
+      return(GetWord<SEN6x_GET_SET_AMBIENT_PRESS>(val, false));
+    }
+
+    uint8_t SetAmbientPressure(uint16_t val) {
+      if (val < 700 || val > 1200) return(SEN6x_ERR_PARAMETER);
+      return(SetWord<SEN6x_GET_SET_AMBIENT_PRESS>(val, false));
+    }
+
+    uint8_t GetAltitude(uint16_t *val) {
+      return(GetWord<SEN6x_GET_SET_ALTITUDE>(val, true));
+    }
+
+    uint8_t SetAltitude(uint16_t val) {
+      if (val > 3000) return(SEN6x_ERR_PARAMETER);
+      return(SetWord<SEN6x_GET_SET_ALTITUDE>(val, true));
+    }
+
+  private:
+    SEN6xTransport *_transport;
+    bool _started;                // indicate the measurement has started
+    bool _restart;                // whether to restart after executing command
+    bool _config;                 // between beginConfig() and commit()
+    bool _configRestart;          // restart measurement on commit()
+
+    /**
+     * opcode and execution time of command C on this device
+     * (evaluated at compile time)
+     */
+    template<Sen6x_Comds_offset C>
+    struct Cmd {
+      static constexpr uint16_t opcode = SEN6xCommandTable.cmd[D][C].opcode;
+      static constexpr uint16_t exectime = SEN6xCommandTable.cmd[D][C].exectime;
+      static constexpr bool supported = (opcode != 0x0000);
+    };
+
+    /** word i of a received frame (2 data bytes + CRC per word) */
+    static uint16_t Word(const uint8_t *f, uint8_t i) {
+      return((uint16_t) f[i * 3] << 8 | f[i * 3 + 1]);
+    }
+
+    /** layout tables in SEN6xLayoutTable */
+    enum { LayoutValues, LayoutRaw, LayoutConc };
+
+    /** number of entries in a row of layout table T */
+    static constexpr uint8_t Fields(uint8_t T) {
+      return(T == LayoutValues ? SEN6x_VALUES_FIELDS : T == LayoutRaw ? SEN6x_RAW_FIELDS : SEN6x_CONC_FIELDS);
+    }
+
+    /** entry I of layout table T for this device */
+    static constexpr struct sen6x_field Entry(uint8_t T, uint8_t I) {
+      return(T == LayoutValues ? SEN6xLayoutTable.values[D][I] :
+             T == LayoutRaw ? SEN6xLayoutTable.raw[D][I] : SEN6xLayoutTable.conc[D][I]);
+    }
+
+    /**
+     * decode entry I to the end of layout table T, as SEN6x_DecodeFrame()
+     * and SEN6x_DecodeFixed() do at run time.
+     *
+     * The word, type and offset are constants, so each field compiles to
+     * a load and a store. Nothing of the table is stored.
+     */
+    template<uint8_t T, uint8_t I, bool END = (I == Fields(T))>
+    struct Decode {
+      static constexpr uint8_t word = Entry(T, I).word;
+      static constexpr uint8_t type = Entry(T, I).type;
+      static constexpr uint8_t offset = Entry(T, I).offset;
+      static constexpr float scale = (type & SEN6x_L_SCALE) == SEN6x_L_1 ? 1 :
+                                     (type & SEN6x_L_SCALE) == SEN6x_L_10 ? 10 :
+                                     (type & SEN6x_L_SCALE) == SEN6x_L_100 ? 100 : 200;
+
+      static uint16_t Val(const uint8_t *f) {
+        return(word == SEN6x_L_NONE ? 0 : Word(f, word));
+      }
+
+      static void Frame(const uint8_t *f, uint8_t *d) {
+        uint16_t val = Val(f);
+        float fl;
+
+        if (type & SEN6x_L_FLOAT) {
+          if (word == SEN6x_L_NONE) fl = 0;
+          else if (type & SEN6x_L_SIGNED) fl = (val == 0x7FFF) ? NAN : (int16_t) val / scale;
+          else fl = (val == 0xFFFF) ? NAN : val / scale;
+
+          memcpy(d + offset, &fl, sizeof(float));
+        }
+        else
+          memcpy(d + offset, &val, sizeof(uint16_t));
+
+        Decode<T, I + 1>::Frame(f, d);
+      }
+
+      static void Fixed(const uint8_t *f, uint8_t *d) {
+        uint16_t val = Val(f);
+
+        memcpy(d + I * sizeof(uint16_t), &val, sizeof(uint16_t));
+
+        Decode<T, I + 1>::Fixed(f, d);
+      }
+    };
+
+    template<uint8_t T, uint8_t I>
+    struct Decode<T, I, true> {
+      static void Frame(const uint8_t *f, uint8_t *d) { (void) f; (void) d; }
+      static void Fixed(const uint8_t *f, uint8_t *d) { (void) f; (void) d; }
+    };
+
+    /**
+     * @brief : send command C with parameters, wait the execution time
+     * and read the answer frame.
+     *
+     * @param par : parameter words
+     * @param n   : number of parameter words (max 6)
+     * @param f   : to store the answer frame (CRC is checked)
+     * @param len : length of answer frame (0 = no answer)
+     */
+    template<Sen6x_Comds_offset C>
+    uint8_t Exec(const uint16_t *par = NULL, uint8_t n = 0, uint8_t *f = NULL, uint8_t len = 0) {
+      static_assert(Cmd<C>::supported, "command is not supported by this SEN6x device");
+
+      uint8_t buf[2 + 6 * 3], i = 0, j, got;
+      unsigned long st;
+
+      if (_transport == NULL) return(SEN6x_ERR_CMDSTATE);
+
+      buf[i++] = Cmd<C>::opcode >> 8;
+      buf[i++] = Cmd<C>::opcode & 0xff;
+
+      for (j = 0; j < n && j < 6; j++) {
+        buf[i] = par[j] >> 8;
+        buf[i + 1] = par[j] & 0xff;
+        buf[i + 2] = SEN6x_CRC(&buf[i]);
+        i += 3;
+      }
+
+      if (_transport->write(Address, buf, i) != SEN6x_ERR_OK) return(SEN6x_ERR_PROTOCOL);
+
+      // Taking enough time for the command to execute on device.
+      st = millis();
+      while (millis() - st < Cmd<C>::exectime) yield();
+
+      if (len == 0) return(SEN6x_ERR_OK);
+
+      _transport->read(Address, f, len, &got);
+
+      if (got != len) return(SEN6x_ERR_PROTOCOL);
+
+      if (SEN6x_CheckFrame(f, len) != len / 3) return(SEN6x_ERR_PROTOCOL);
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : read zero terminated serial number or product name
+     */
+    template<Sen6x_Comds_offset C>
+    uint8_t GetInfo(char *ser, uint8_t len) {
+      uint8_t f[SEN6xT_INFO_FRAME], i, j, ret;
+
+      if (len == 0) return(SEN6x_ERR_PARAMETER);
+
+      ret = Exec<C>(NULL, 0, f, sizeof(f));
+
+      if (ret != SEN6x_ERR_OK) {
+        ser[0] = 0x0;
+        return(ret);
+      }
+
+      for (i = 0, j = 0; i < len - 1 && j < sizeof(f); i++, j++) {
+        if (j % 3 == 2) j++;
+        ser[i] = f[j];
+        if (ser[i] == 0x0) return(SEN6x_ERR_OK);
+      }
+
+      ser[i] = 0x0;
+
+      return(SEN6x_ERR_OK);
+    }
+
+    /**
+     * @brief : get / set VOC or NOx tuning parameters in idle mode
+     */
+    template<Sen6x_Comds_offset C>
+    uint8_t GetXox(sen6x_xox *x) {
+      uint8_t f[18], ret;
+
+      if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      ret = Exec<C>(NULL, 0, f, sizeof(f));
+
+      if (ret == SEN6x_ERR_OK) {
+        x->IndexOffset = (int16_t) Word(f, 0);
+        x->LearnTimeOffsetHours = (int16_t) Word(f, 1);
+        x->LearnTimeGainHours = (int16_t) Word(f, 2);
+        x->GateMaxDurationMin = (int16_t) Word(f, 3);
+        x->stdInitial = (int16_t) Word(f, 4);
+        x->GainFactor = (int16_t) Word(f, 5);
+      }
+
+      if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    template<Sen6x_Comds_offset C>
+    uint8_t SetXox(sen6x_xox *x) {
+      uint16_t p[6] = {(uint16_t) x->IndexOffset, (uint16_t) x->LearnTimeOffsetHours,
+                       (uint16_t) x->LearnTimeGainHours, (uint16_t) x->GateMaxDurationMin,
+                       (uint16_t) x->stdInitial, (uint16_t) x->GainFactor};
+      uint8_t ret;
+
+      if (! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      ret = Exec<C>(p, 6);
+
+      if (! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    /**
+     * @brief : get / set a one word parameter
+     *
+     * @param idle : true if the command can NOT be done when measuring
+     */
+    template<Sen6x_Comds_offset C>
+    uint8_t GetWord(uint16_t *val, bool idle) {
+      uint8_t f[3], ret;
+
+      if (idle && ! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      ret = Exec<C>(NULL, 0, f, sizeof(f));
+
+      if (ret == SEN6x_ERR_OK) *val = Word(f, 0);
+
+      if (idle && ! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    template<Sen6x_Comds_offset C>
+    uint8_t SetWord(uint16_t val, bool idle) {
+      uint8_t ret;
+
+      if (idle && ! CheckToStop()) return(SEN6x_ERR_PROTOCOL);
+
+      ret = Exec<C>(&val, 1);
+
+      if (idle && ! CheckWasStarted()) return(SEN6x_ERR_PROTOCOL);
+
+      return(ret);
+    }
+
+    /**
+     * @brief stop the measurement if started (restart with CheckWasStarted())
+     */
+    bool CheckToStop() {
+      _restart = false;
+
+      if (_started) {
+        if (! stop()) return(false);
+        _restart = true;
+      }
+
+      return(true);
+    }
+
+    /**
+     * @brief Start the sensor if stopped e.g. during CheckToStop()
+     */
+    bool CheckWasStarted() {
+      // no measurement between beginConfig() and commit()
+      if (_restart && _config) {
+        _restart = false;
+        return(false);
+      }
+
+      if (_restart) {
+        unsigned long t = millis();
+
+        if (! start()) return(false);
+
+        // first measurement is ready about 1 second after start
+        while (millis() - t < SEN6x_START_WAIT) yield();
+
+        _restart = false;
+      }
+
+      return(true);
+    }
+};
+
+#endif /* SEN6x_TEMPLATE_H */
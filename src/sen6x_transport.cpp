@@ -0,0 +1,222 @@
+/**
+ * SEN6x Library transport file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Contains the default implementation of the transport interface and
+ * the transport for Arduino TwoWire.
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ * - added recover()
+ *********************************************************************
+ */
+
+#include "sen6x.h"
+
+////////////////////// transport interface /////////////////////
+//************************************************************/
+
+/**
+ * @brief : write a frame and read the answer (default)
+ */
+uint8_t SEN6xTransport::writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen,
+                                  uint8_t *rbuf, uint8_t rlen, uint8_t *got)
+{
+  uint8_t ret;
+
+  *got = 0;
+
+  ret = write(addr, wbuf, wlen);
+
+  if (ret != SEN6x_ERR_OK) return(ret);
+
+  return(read(addr, rbuf, rlen, got));
+}
+
+/**
+ * @brief : set the I2C clock (default : not supported)
+ */
+uint8_t SEN6xTransport::setClock(uint32_t clock)
+{
+  (void) clock;
+
+  return(SEN6x_ERR_UNKNOWNCMD);
+}
+
+/**
+ * @brief : recover the bus (default : not supported)
+ */
+uint8_t SEN6xTransport::recover()
+{
+  return(SEN6x_ERR_UNKNOWNCMD);
+}
+
+////////////////////// TwoWire transport ///////////////////////
+//************************************************************/
+#if not defined SEN6x_HOST
+
+SEN6xTwoWire::SEN6xTwoWire(TwoWire *port)
+{
+  _port = port;
+  _SCL = _SDA = SEN6x_NO_PIN;
+}
+
+void SEN6xTwoWire::SetPort(TwoWire *port)
+{
+  _port = port;
+}
+
+void SEN6xTwoWire::SetPins(uint8_t scl, uint8_t sda)
+{
+  _SCL = scl;
+  _SDA = sda;
+}
+
+/**
+ * @brief : write frame with TwoWire
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : no port set
+ *  SEN6x_ERR_PROTOCOL : no acknowledge or other bus error
+ */
+uint8_t SEN6xTwoWire::write(uint8_t addr, const uint8_t *buf, uint8_t len)
+{
+  if (_port == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  _port->beginTransmission(addr);
+  _port->write(buf, len);
+
+  if (_port->endTransmission() != 0) return(SEN6x_ERR_PROTOCOL);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : read frame with TwoWire
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : no port set
+ *  SEN6x_ERR_PROTOCOL : not all bytes received
+ */
+uint8_t SEN6xTwoWire::read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got)
+{
+  uint8_t i = 0;
+
+  *got = 0;
+
+  if (_port == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  _port->requestFrom(addr, len);
+
+  while (_port->available()) {
+
+    if (i < len) buf[i++] = _port->read();
+
+    // flush any bytes pending (if NOT clearing rxBuffer)
+    else _port->read();
+  }
+
+  *got = i;
+
+  if (i != len) return(SEN6x_ERR_PROTOCOL);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : set the I2C clock of TwoWire
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : no port set
+ */
+uint8_t SEN6xTwoWire::setClock(uint32_t clock)
+{
+  if (_port == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  _port->setClock(clock);
+
+  return(SEN6x_ERR_OK);
+}
+
+/**
+ * @brief : recover the bus (NXP UM10204, 3.1.16 bus clear)
+ *
+ * The pins are set with SetPins() (SEN6x::SetBusPins()), without them
+ * nothing is done. They are driven open drain : low as output,
+ * released as input with pull-up. At 100kHz SCL is clocked until the
+ * device releases SDA, followed by a stop condition. TwoWire is started
+ * again afterwards.
+ *
+ * @return
+ *  SEN6x_ERR_OK = ok
+ *  SEN6x_ERR_CMDSTATE : no port set
+ *  SEN6x_ERR_UNKNOWNCMD : no pins set (see SetPins())
+ *  SEN6x_ERR_PROTOCOL : bus is still held low
+ */
+uint8_t SEN6xTwoWire::recover()
+{
+  uint8_t i;
+  bool ok;
+
+  if (_port == NULL) return(SEN6x_ERR_CMDSTATE);
+
+  if (_SCL == SEN6x_NO_PIN || _SDA == SEN6x_NO_PIN) return(SEN6x_ERR_UNKNOWNCMD);
+
+  // release the pins from the I2C peripheral. The ESP8266 Wire and the
+  // SoftWire (SCD30_SEN6x_ESP32) have no end(), their pins are plain GPIO
+#if not defined ARDUINO_ARCH_ESP8266 && not defined SCD30_SEN6x_ESP32
+  _port->end();
+#endif
+
+  pinMode(_SDA, INPUT_PULLUP);
+  pinMode(_SCL, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  // at most 9 clocks : 8 data bits and acknowledge
+  for (i = 0; i < 9 && digitalRead(_SDA) == LOW; i++) {
+    digitalWrite(_SCL, LOW);
+    pinMode(_SCL, OUTPUT);
+    delayMicroseconds(5);
+    pinMode(_SCL, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+
+  // stop condition : SDA low to high while SCL is high
+  digitalWrite(_SCL, LOW);
+  pinMode(_SCL, OUTPUT);
+  delayMicroseconds(5);
+  digitalWrite(_SDA, LOW);
+  pinMode(_SDA, OUTPUT);
+  delayMicroseconds(5);
+  pinMode(_SCL, INPUT_PULLUP);
+  delayMicroseconds(5);
+  pinMode(_SDA, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  ok = (digitalRead(_SDA) == HIGH && digitalRead(_SCL) == HIGH);
+
+#if defined ARDUINO_ARCH_ESP32 && not defined SCD30_SEN6x_ESP32
+  _port->begin(_SDA, _SCL);
+#else
+  _port->begin();
+#endif
+
+  return(ok ? SEN6x_ERR_OK : SEN6x_ERR_PROTOCOL);
+}
+#endif // SEN6x_HOST
@@ -0,0 +1,151 @@
+/**
+ * SEN6x Library transport interface
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * The library is not hard-wired to TwoWire. All communication with the
+ * SEN6x is done through a transport. A transport works on whole frames
+ * (command + data + CRC as send or received on the I2C bus). This allows
+ * a backend to use native bulk or DMA transfers.
+ *
+ * Available transports:
+ *  SEN6xTwoWire  : Arduino TwoWire (default, used with begin(TwoWire *))
+ *  SEN6xLinuxI2C : Linux i2c-dev (see sen6x_linux.h)
+ *  SEN6xSim      : SEN6x simulator for testing (see sen6x_sim.h)
+ *
+ * To add your own transport, derive from SEN6xTransport and implement
+ * write() and read(). Optional writeRead() can be overruled in case the
+ * backend supports a combined write-then-read transfer, setClock() in
+ * case the backend can change the I2C clock and recover() in case the
+ * backend can clock the bus free.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ * - added recover()
+ *********************************************************************
+ *
+ * This file is included from sen6x.h
+ */
+#ifndef SEN6x_TRANSPORT_H
+#define SEN6x_TRANSPORT_H
+
+class SEN6xTransport
+{
+  public:
+
+    /**
+     * @brief : write a frame to the device
+     *
+     * @param addr : I2C address
+     * @param buf  : frame to write
+     * @param len  : number of bytes in frame
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  else error (e.g. SEN6x_ERR_PROTOCOL when NACK)
+     */
+    virtual uint8_t write(uint8_t addr, const uint8_t *buf, uint8_t len) = 0;
+
+    /**
+     * @brief : read a frame from the device
+     *
+     * @param addr : I2C address
+     * @param buf  : to store the frame
+     * @param len  : number of bytes to read
+     * @param got  : number of bytes actually received
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok, all bytes received
+     *  else error
+     */
+    virtual uint8_t read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got) = 0;
+
+    /**
+     * @brief : write a frame and read the answer.
+     *
+     * Only for commands that do NOT need execution time on the device.
+     * Default : write() followed by read()
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  else error
+     */
+    virtual uint8_t writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen,
+                              uint8_t *rbuf, uint8_t rlen, uint8_t *got);
+
+    /**
+     * @brief : set the I2C clock
+     *
+     * @param clock : clock in Hz
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_UNKNOWNCMD : not supported (default)
+     */
+    virtual uint8_t setClock(uint32_t clock);
+
+    /**
+     * @brief : recover the bus when a device holds SDA low
+     *
+     * Clock SCL (at most 9 times) until SDA is released and send a stop
+     * condition. The clock can be lost, the driver sets it again.
+     *
+     * SEN6xTwoWire releases the port with end() first (AVR, SAMD, mbed,
+     * Renesas, RP2040, ESP32 ...). ESP8266 and SoftWire have no end(),
+     * there the pins are used directly.
+     *
+     * @return
+     *  SEN6x_ERR_OK = ok
+     *  SEN6x_ERR_PROTOCOL : bus is still held low
+     *  SEN6x_ERR_UNKNOWNCMD : not supported (default)
+     */
+    virtual uint8_t recover();
+};
+
+#if not defined SEN6x_HOST
+#define SEN6x_NO_PIN          0xFF
+
+/**
+ * Transport for Arduino TwoWire
+ */
+class SEN6xTwoWire : public SEN6xTransport
+{
+  public:
+
+    SEN6xTwoWire(TwoWire *port = NULL);
+
+    /**
+     * @brief : set the I2C port to use
+     *
+     * User must have performed the wirePort.begin() in the sketch.
+     */
+    void SetPort(TwoWire *port);
+
+    /**
+     * @brief : set the pins of the port, needed for recover()
+     */
+    void SetPins(uint8_t scl, uint8_t sda);
+
+    uint8_t write(uint8_t addr, const uint8_t *buf, uint8_t len);
+    uint8_t read(uint8_t addr, uint8_t *buf, uint8_t len, uint8_t *got);
+    uint8_t setClock(uint32_t clock);
+    uint8_t recover();
+
+  private:
+    TwoWire *_port;
+    uint8_t _SCL, _SDA;
+};
+#endif // SEN6x_HOST
+
+#endif /* SEN6x_TRANSPORT_H */
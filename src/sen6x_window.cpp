@@ -0,0 +1,102 @@
+/**
+ * SEN6x Library moving window file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * Moving window with a running mean (see sen6x_window.h).
+ *
+ * ================ Disclaimer ===================================
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+
+#include "sen6x_window.h"
+
+void SEN6x_WindowClear(struct sen6x_window *w)
+{
+  w->cur = 0;
+  w->moves = 0;
+  w->started = false;
+}
+
+uint8_t SEN6x_WindowMoves(struct sen6x_window *w, unsigned long t)
+{
+  unsigned long n;
+
+  if (! w->started) {
+    w->start = t;
+    w->started = true;
+    return(0);
+  }
+
+  if (t - w->start < w->span) return(0);
+
+  n = (t - w->start) / w->span;
+
+  if (n >= w->buckets) {
+    SEN6x_WindowClear(w);
+    w->start = t;
+    w->started = true;
+    return(w->buckets);
+  }
+
+  w->start += n * w->span;
+
+  return(n);
+}
+
+bool SEN6x_WindowMove(struct sen6x_window *w)
+{
+  w->cur = (w->cur + 1) % w->buckets;
+
+  if (++w->moves < w->buckets) return(false);
+
+  w->moves = 0;
+  return(true);
+}
+
+void SEN6x_AvgAdd(struct sen6x_avg *b, float x)
+{
+  b->sum += x;
+  b->count++;
+}
+
+void SEN6x_AvgMove(struct sen6x_avg_total *t, struct sen6x_avg *b, uint8_t cur, uint8_t next)
+{
+  t->sum += b[cur].sum - b[next].sum;
+  t->count += b[cur].count;
+  t->count -= b[next].count;
+  b[next].sum = 0;
+  b[next].count = 0;
+}
+
+void SEN6x_AvgSum(struct sen6x_avg_total *t, const struct sen6x_avg *b, uint8_t n, uint8_t cur)
+{
+  uint8_t i;
+
+  t->sum = 0;
+
+  for (i = 0; i < n; i++)
+    if (i != cur) t->sum += b[i].sum;
+}
+
+float SEN6x_AvgMean(const struct sen6x_avg_total *t, const struct sen6x_avg *cur)
+{
+  uint32_t count = t->count + cur->count;
+
+  if (count == 0) return(NAN);
+
+  return((t->sum + cur->sum) / count);
+}
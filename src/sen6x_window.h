@@ -0,0 +1,119 @@
+/**
+ * SEN6x Library moving window header file
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * All rights reserved.
+ *
+ * A moving window split in buckets of equal time, with a running mean.
+ * Used by SEN6xStats (sen6x_stats.h) and SEN6xAQI (sen6x_aqi.h).
+ *
+ * A bucket keeps the sum and count of the samples in its part of the
+ * window. When the time of the current bucket has passed, it is added to
+ * the running sum of the window and the oldest bucket is removed. The
+ * cost of a sample does not depend on the length of the window.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ * Version 1.11 / October 2026 / paulvha
+ * - initial version
+ *********************************************************************
+ */
+#ifndef SEN6x_WINDOW_H
+#define SEN6x_WINDOW_H
+
+#include "sen6x.h"
+
+/**
+ * time of a window
+ */
+struct sen6x_window {
+  unsigned long span;                     // mS per bucket (0 : not used)
+  unsigned long start;                    // millis() current bucket started
+  uint8_t buckets;
+  uint8_t cur;                            // current bucket
+  uint8_t moves;                          // moves since sums were added up
+  bool started;
+};
+
+/**
+ * bucket of a mean
+ */
+struct sen6x_avg {
+  float sum;
+  uint16_t count;
+};
+
+/**
+ * buckets of a mean before the current bucket
+ */
+struct sen6x_avg_total {
+  float sum;
+  uint32_t count;
+};
+
+/**
+ * @brief : start the window again (the buckets must be cleared)
+ */
+void SEN6x_WindowClear(struct sen6x_window *w);
+
+/**
+ * @brief : number of buckets to move the window for a sample
+ *
+ * @param t : time of the sample in mS
+ *
+ * @return
+ *  0 - buckets-1 : move the window this number of buckets
+ *  buckets : gap of a window or more. The window is started again at
+ *            t, the buckets must be cleared.
+ */
+uint8_t SEN6x_WindowMoves(struct sen6x_window *w, unsigned long t);
+
+/**
+ * @brief : move the window one bucket
+ *
+ * @return
+ *  true : the running sums must be added up again with SEN6x_AvgSum(),
+ *         else rounding errors accumulate.
+ */
+bool SEN6x_WindowMove(struct sen6x_window *w);
+
+/**
+ * @brief : add a sample to a bucket
+ */
+void SEN6x_AvgAdd(struct sen6x_avg *b, float x);
+
+/**
+ * @brief : move the running sum of a mean one bucket
+ *
+ * Bucket cur is added to the total. Bucket next (the oldest) is removed
+ * and cleared, it becomes the current bucket.
+ *
+ * @param b : buckets of the mean
+ */
+void SEN6x_AvgMove(struct sen6x_avg_total *t, struct sen6x_avg *b, uint8_t cur, uint8_t next);
+
+/**
+ * @brief : add up the running sum of a mean again
+ *
+ * @param b   : buckets of the mean
+ * @param n   : number of buckets
+ * @param cur : current bucket (not in the running sum)
+ */
+void SEN6x_AvgSum(struct sen6x_avg_total *t, const struct sen6x_avg *b, uint8_t n, uint8_t cur);
+
+/**
+ * @brief : mean of the running sum and the current bucket
+ *
+ * @return mean or NAN if no samples
+ */
+float SEN6x_AvgMean(const struct sen6x_avg_total *t, const struct sen6x_avg *cur);
+
+#endif /* SEN6x_WINDOW_H */